@@ -0,0 +1,120 @@
+/*
+
+Copyright (c) 2021 - 2023 Pavel Artemkin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+// Replacements of the global allocation functions which count allocations
+// and track the amount of allocated memory.
+
+#include "harness.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<std::uint64_t> g_count{0};
+std::atomic<std::uint64_t> g_bytes{0};
+std::atomic<std::uint64_t> g_live{0};
+std::atomic<std::uint64_t> g_peak{0};
+
+// Every block is prefixed with its size to account freed memory.
+// The prefix keeps the fundamental alignment of the returned pointer.
+constexpr std::size_t kHeaderSize = alignof(std::max_align_t);
+
+void update_peak(const std::uint64_t live) noexcept {
+  auto peak = g_peak.load(std::memory_order_relaxed);
+  while (live > peak &&
+         !g_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+  {
+  }
+}
+
+void* allocate(const std::size_t size) {
+  auto* block = static_cast<unsigned char*>(std::malloc(kHeaderSize + size));
+  if (block == nullptr) {
+    throw std::bad_alloc();
+  }
+  *reinterpret_cast<std::size_t*>(block) = size;
+
+  g_count.fetch_add(1, std::memory_order_relaxed);
+  g_bytes.fetch_add(size, std::memory_order_relaxed);
+  update_peak(g_live.fetch_add(size, std::memory_order_relaxed) + size);
+
+  return block + kHeaderSize;
+}
+
+void deallocate(void* ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  auto* block = static_cast<unsigned char*>(ptr) - kHeaderSize;
+
+  g_live.fetch_sub(*reinterpret_cast<std::size_t*>(block),
+    std::memory_order_relaxed);
+  std::free(block);
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+  return allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+  return allocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+  deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+  deallocate(ptr);
+}
+
+namespace bench {
+
+allocation_stats allocations() noexcept {
+  return allocation_stats{
+    g_count.load(std::memory_order_relaxed),
+    g_bytes.load(std::memory_order_relaxed),
+    g_live.load(std::memory_order_relaxed),
+    g_peak.load(std::memory_order_relaxed)};
+}
+
+void reset_peak_allocations() noexcept {
+  g_peak.store(g_live.load(std::memory_order_relaxed),
+    std::memory_order_relaxed);
+}
+
+} // namespace bench
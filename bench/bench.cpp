@@ -0,0 +1,302 @@
+/*
+
+Copyright (c) 2021 - 2023 Pavel Artemkin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+// Benchmarks of parsing command lines, converting values and formatting help.
+
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "cxxopts.hpp"
+#include "harness.hpp"
+
+namespace {
+
+struct point {
+  int x = 0;
+  int y = 0;
+};
+
+std::istream& operator>>(std::istream& in, point& p) {
+  char separator = 0;
+  return in >> p.x >> separator >> p.y;
+}
+
+cxxopts::options make_options() {
+  cxxopts::options options("bench", " - a sample program");
+  options.add_options()
+    ("a,all", "Show all")
+    ("b,brief", "Brief output")
+    ("c,color", "Colorize output")
+    ("d,debug", "Debug output")
+    ("e,exact", "Exact match")
+    ("v,verbose", "Verbose output")
+    ("n,threads", "Number of threads", cxxopts::value<unsigned>())
+    ("l,level", "Compression level", cxxopts::value<int>()->default_value("6"))
+    ("r,ratio", "Sampling ratio", cxxopts::value<double>())
+    ("o,output", "Output file", cxxopts::value<std::string>())
+    ("ids", "List of ids", cxxopts::value<std::vector<int64_t>>())
+    ("weights", "List of weights", cxxopts::value<std::vector<double>>())
+    ("tags", "List of tags", cxxopts::value<std::vector<std::string>>())
+    ("inputs", "Input files", cxxopts::value<std::vector<std::string>>());
+  options.add_options("Advanced")
+    ("cache-size", "Size of the cache in bytes", cxxopts::value<uint64_t>())
+    ("tab-expansion", "Tab\texpansion\tin\tdescription")
+    ("long-description",
+      "A very long description of the option which does not fit into a "
+      "single line of the help and has to be wrapped several times to be "
+      "displayed inside of the given width");
+  options.parse_positional("inputs");
+  return options;
+}
+
+void run_parse(const std::vector<const char*>& argv,
+               const std::size_t iterations,
+               const bool compile = false) {
+  auto options = make_options();
+  if (compile) {
+    options.compile();
+  }
+  for (std::size_t i = 0; i != iterations; ++i) {
+    const auto result =
+      options.parse(static_cast<int>(argv.size()), argv.data());
+    bench::do_not_optimize(result);
+  }
+}
+
+const std::vector<const char*> kShortArgs{
+  "bench", "-v", "-n", "4", "-o", "out.txt", "-l", "9"};
+
+const std::vector<const char*> kLongArgs{
+  "bench", "--verbose", "--threads=4", "--output", "out.txt", "--level=9",
+  "--ratio", "0.25", "--cache-size=1048576"};
+
+const std::vector<const char*> kClusteredArgs{
+  "bench", "-abcdev", "-n4", "-vvvv"};
+
+const std::vector<const char*> kPositionalArgs{
+  "bench", "a.txt", "b.txt", "c.txt", "d.txt", "e.txt", "f.txt", "g.txt",
+  "h.txt", "i.txt", "j.txt", "k.txt", "l.txt", "m.txt", "n.txt", "o.txt"};
+
+const std::vector<const char*> kVectorArgs{
+  "bench",
+  "--ids", "1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16",
+  "--weights", "0.5,1.25,2.5,5,10,20,40,80",
+  "--tags", "alpha,beta,gamma,delta,epsilon",
+  "--ids=100,200,300,400", "--tags=zeta,eta,theta"};
+
+const std::vector<const char*> kUnmatchedArgs{
+  "bench", "-v", "--forward-option=value", "--another-forwarded-option",
+  "-xyz", "-n", "4", "--", "a-file-name-for-the-child.txt",
+  "another-file-name-for-the-child.txt", "--child-flag"};
+
+void run_parse_unmatched(const std::size_t iterations, const bool views) {
+  auto options = make_options();
+  options.allow_unrecognised_options().view_unmatched(views).compile();
+  cxxopts::parse_result result;
+  for (std::size_t i = 0; i != iterations; ++i) {
+    options.parse(static_cast<int>(kUnmatchedArgs.size()),
+                  kUnmatchedArgs.data(), result);
+    bench::do_not_optimize(result);
+  }
+}
+
+struct config {
+  bool verbose = false;
+  unsigned threads = 1;
+  int level = 6;
+  double ratio = 0;
+  std::string output{};
+  uint64_t cache_size = 0;
+};
+
+void run_parse_struct(const std::vector<const char*>& argv,
+                      const std::size_t iterations) {
+  cxxopts::struct_options<config> options("bench");
+  options.add_options()
+    ("v,verbose", "Verbose output", &config::verbose)
+    ("n,threads", "Number of threads", &config::threads)
+    ("l,level", "Compression level", &config::level)
+    ("r,ratio", "Sampling ratio", &config::ratio)
+    ("o,output", "Output file", &config::output)
+    ("cache-size", "Size of the cache in bytes", &config::cache_size);
+
+  for (std::size_t i = 0; i != iterations; ++i) {
+    config cfg;
+    const auto unmatched =
+      options.parse(static_cast<int>(argv.size()), argv.data(), cfg);
+    bench::do_not_optimize(cfg);
+    bench::do_not_optimize(unmatched);
+  }
+}
+
+void run_add_options(const std::size_t iterations, const bool arena) {
+  std::vector<std::string> names;
+  for (std::size_t i = 0; i != 100; ++i) {
+    names.push_back("generated-option-" + std::to_string(i));
+  }
+  for (std::size_t i = 0; i != iterations; ++i) {
+    cxxopts::options options("bench");
+    options.use_arena(arena);
+    for (const auto& name : names) {
+      options.add_options()(name, "Generated option", cxxopts::value<int>());
+    }
+    bench::do_not_optimize(options);
+  }
+}
+
+template <typename T>
+void run_parse_value(const std::string& text, const std::size_t iterations) {
+  for (std::size_t i = 0; i != iterations; ++i) {
+    T value;
+    cxxopts::detail::parse_value(text, value);
+    bench::do_not_optimize(value);
+  }
+}
+
+template <typename T>
+void run_split(const std::string& text, const std::size_t iterations) {
+  cxxopts::value_parser<std::vector<T>> parser;
+  const cxxopts::parse_context ctx{};
+  for (std::size_t i = 0; i != iterations; ++i) {
+    std::vector<T> values;
+    parser.parse(ctx, text, values);
+    bench::do_not_optimize(values);
+  }
+}
+
+void run_help(const std::size_t iterations, const bool tab_expansion) {
+  auto options = make_options();
+  options.set_tab_expansion(tab_expansion);
+  for (std::size_t i = 0; i != iterations; ++i) {
+    const auto text = options.help({"", "Advanced"});
+    bench::do_not_optimize(text);
+  }
+}
+
+} // namespace
+
+BENCHMARK("parse/short", parse_short) {
+  run_parse(kShortArgs, iterations);
+}
+
+BENCHMARK("parse/long", parse_long) {
+  run_parse(kLongArgs, iterations);
+}
+
+BENCHMARK("parse/clustered", parse_clustered) {
+  run_parse(kClusteredArgs, iterations);
+}
+
+BENCHMARK("parse/positional", parse_positional) {
+  run_parse(kPositionalArgs, iterations);
+}
+
+BENCHMARK("parse/vectors", parse_vectors) {
+  run_parse(kVectorArgs, iterations);
+}
+
+BENCHMARK("parse/long/compiled", parse_long_compiled) {
+  run_parse(kLongArgs, iterations, true);
+}
+
+BENCHMARK("parse/long/struct", parse_long_struct) {
+  run_parse_struct(kLongArgs, iterations);
+}
+
+BENCHMARK("parse/unmatched", parse_unmatched) {
+  run_parse_unmatched(iterations, false);
+}
+
+BENCHMARK("parse/unmatched/views", parse_unmatched_views) {
+  run_parse_unmatched(iterations, true);
+}
+
+BENCHMARK("spec/add_options", spec_add_options) {
+  run_add_options(iterations, false);
+}
+
+BENCHMARK("spec/add_options/arena", spec_add_options_arena) {
+  run_add_options(iterations, true);
+}
+
+BENCHMARK("parse_value/int", parse_value_int) {
+  run_parse_value<int>("-123456", iterations);
+}
+
+BENCHMARK("parse_value/uint64", parse_value_uint64) {
+  run_parse_value<uint64_t>("18446744073709551615", iterations);
+}
+
+BENCHMARK("parse_value/hex", parse_value_hex) {
+  run_parse_value<uint32_t>("0xdeadbeef", iterations);
+}
+
+BENCHMARK("parse_value/float", parse_value_float) {
+  run_parse_value<float>("3.14159", iterations);
+}
+
+BENCHMARK("parse_value/double", parse_value_double) {
+  run_parse_value<double>("-12345.6789e-3", iterations);
+}
+
+BENCHMARK("parse_value/long_double", parse_value_long_double) {
+  run_parse_value<long double>("2.718281828459045", iterations);
+}
+
+BENCHMARK("parse_value/bool", parse_value_bool) {
+  run_parse_value<bool>("false", iterations);
+}
+
+BENCHMARK("parse_value/char", parse_value_char) {
+  run_parse_value<char>("x", iterations);
+}
+
+BENCHMARK("parse_value/string", parse_value_string) {
+  run_parse_value<std::string>("a value longer than small string", iterations);
+}
+
+BENCHMARK("parse_value/stream", parse_value_stream) {
+  run_parse_value<point>("12,34", iterations);
+}
+
+BENCHMARK("split/int", split_int) {
+  run_split<int>("1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16", iterations);
+}
+
+BENCHMARK("split/double", split_double) {
+  run_split<double>("0.5,1.25,2.5,5,10,20,40,80", iterations);
+}
+
+BENCHMARK("split/string", split_string) {
+  run_split<std::string>("alpha,beta,gamma,delta,epsilon,zeta", iterations);
+}
+
+BENCHMARK("help", help) {
+  run_help(iterations, false);
+}
+
+BENCHMARK("help/tab_expansion", help_tab_expansion) {
+  run_help(iterations, true);
+}
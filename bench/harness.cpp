@@ -0,0 +1,139 @@
+/*
+
+Copyright (c) 2021 - 2023 Pavel Artemkin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+#include "harness.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+#include "cxxopts.hpp"
+
+namespace {
+
+struct measurement {
+  std::size_t iterations;
+  double nanoseconds;
+  bench::allocation_stats allocations;
+};
+
+measurement measure(const bench::benchmark& b, std::size_t iterations) {
+  const auto before = bench::allocations();
+  const auto start = std::chrono::steady_clock::now();
+  b.run(iterations);
+  const auto finish = std::chrono::steady_clock::now();
+  const auto after = bench::allocations();
+
+  return measurement{
+    iterations,
+    std::chrono::duration<double, std::nano>(finish - start).count(),
+    {after.count - before.count, after.bytes - before.bytes, after.live,
+      after.peak}};
+}
+
+/// Grows the number of iterations until a run takes at least min_time.
+measurement run_benchmark(const bench::benchmark& b, const double min_time) {
+  // Warm up caches and lazily initialized state.
+  auto result = measure(b, 1);
+
+  while (result.nanoseconds < min_time && result.iterations < (1u << 30)) {
+    // Aim a bit higher than the required time to avoid extra rounds.
+    const double scale = result.nanoseconds > 0
+      ? 1.4 * min_time / result.nanoseconds
+      : 10.0;
+    const auto next = static_cast<std::size_t>(
+      static_cast<double>(result.iterations) * std::min(scale, 10.0));
+
+    result = measure(b, std::max(next, result.iterations + 1));
+  }
+
+  return result;
+}
+
+} // namespace
+
+namespace bench {
+
+std::vector<benchmark>& registry() {
+  static std::vector<benchmark> benchmarks;
+  return benchmarks;
+}
+
+} // namespace bench
+
+int main(int argc, const char* argv[]) {
+  cxxopts::options options(argv[0], " - run cxxopts benchmarks");
+  options.add_options()
+    ("f,filter", "Run only benchmarks which names contain the string",
+      cxxopts::value<std::string>()->default_value(""), "TEXT")
+    ("t,min-time", "Minimal duration of a measurement in milliseconds",
+      cxxopts::value<double>()->default_value("200"), "MS")
+    ("l,list", "List benchmarks and exit")
+    ("h,help", "Print help");
+
+  try {
+    const auto result = options.parse(argc, argv);
+
+    if (result.count("help")) {
+      std::cout << options.help() << std::endl;
+      return 0;
+    }
+
+    const auto& filter = result["filter"].as<std::string>();
+    const double min_time = result["min-time"].as<double>() * 1e6;
+
+    const bool list_only = result.count("list") != 0;
+
+    if (!list_only) {
+      std::printf("%-32s %12s %12s %12s %14s\n",
+        "benchmark", "iterations", "ns/op", "allocs/op", "bytes/op");
+    }
+
+    for (const auto& b : bench::registry()) {
+      if (b.name.find(filter) == std::string::npos) {
+        continue;
+      }
+      if (list_only) {
+        std::cout << b.name << std::endl;
+        continue;
+      }
+
+      const auto m = run_benchmark(b, min_time);
+      const auto n = static_cast<double>(m.iterations);
+
+      std::printf("%-32s %12zu %12.1f %12.2f %14.1f\n",
+        b.name.c_str(),
+        m.iterations,
+        m.nanoseconds / n,
+        static_cast<double>(m.allocations.count) / n,
+        static_cast<double>(m.allocations.bytes) / n);
+    }
+  } catch (const cxxopts::option_error& e) {
+    std::cerr << "error parsing options: " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,96 @@
+/*
+
+Copyright (c) 2021 - 2023 Pavel Artemkin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+// A minimal benchmark harness without external dependencies.
+//
+// Each benchmark is a function running its body the given number of times.
+// The harness grows the number of iterations until a run takes long enough
+// and reports the time and the number of heap allocations per iteration.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/// A function running the body of a benchmark `iterations` times.
+using benchmark_fn = void (*)(std::size_t iterations);
+
+struct benchmark {
+  std::string name;
+  benchmark_fn run;
+};
+
+/// Counters of the global allocation functions.
+struct allocation_stats {
+  /// Number of allocations made so far.
+  std::uint64_t count;
+  /// Number of bytes allocated so far.
+  std::uint64_t bytes;
+  /// Number of bytes currently allocated.
+  std::uint64_t live;
+  /// Maximal number of bytes allocated at once since the last reset.
+  std::uint64_t peak;
+};
+
+/// Returns all registered benchmarks in the order of registration.
+std::vector<benchmark>& registry();
+
+/// Returns the number of allocations made by the process so far.
+allocation_stats allocations() noexcept;
+
+/// Resets the peak of allocated memory to the current amount.
+void reset_peak_allocations() noexcept;
+
+struct registrar {
+  registrar(const char* name, benchmark_fn run) {
+    registry().push_back(benchmark{name, run});
+  }
+};
+
+/// Prevents the compiler from optimizing away the computation of a value.
+template <typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+} // namespace bench
+
+#define BENCH_CONCAT_IMPL(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_IMPL(a, b)
+
+/// Defines a benchmark. The body has access to the number of iterations
+/// through the `iterations` parameter.
+#define BENCHMARK(name, fn)                                                  \
+  static void fn(std::size_t iterations);                                   \
+  static const ::bench::registrar BENCH_CONCAT(fn, _registrar){name, fn};   \
+  static void fn(std::size_t iterations)
@@ -0,0 +1,237 @@
+/*
+
+Copyright (c) 2021 - 2023 Pavel Artemkin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+// Scalability benchmarks with generated specifications of up to 10^5 options
+// and command lines of up to 10^6 arguments.
+//
+// Every scenario is run once for each size. The time and the peak amount of
+// heap memory allocated during the run are reported, so super-linear growth
+// is visible by comparing adjacent rows.
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include "cxxopts.hpp"
+#include "harness.hpp"
+
+namespace {
+
+constexpr std::size_t kOptionsPerGroup = 100;
+
+std::string option_name(const std::size_t i) {
+  return "option-" + std::to_string(i);
+}
+
+std::string group_name(const std::size_t i) {
+  return "group-" + std::to_string(i / kOptionsPerGroup);
+}
+
+/// Creates a specification with the given number of integer options.
+cxxopts::options make_options(const std::size_t count) {
+  cxxopts::options options("stress", " - generated specification");
+
+  for (std::size_t i = 0; i != count; ++i) {
+    options.add_options(group_name(i))
+      (option_name(i), "Generated option " + std::to_string(i),
+        cxxopts::value<int>());
+  }
+  options.add_options()
+    ("positional", "Positional arguments",
+      cxxopts::value<std::vector<std::string>>());
+  options.parse_positional("positional");
+
+  return options;
+}
+
+/// Owns the strings of a generated command line.
+class command_line {
+public:
+  void add(std::string arg) {
+    args_.push_back(std::move(arg));
+  }
+
+  std::vector<const char*> argv() const {
+    std::vector<const char*> result;
+    result.reserve(args_.size() + 1);
+    result.push_back("stress");
+    for (const auto& arg : args_) {
+      result.push_back(arg.c_str());
+    }
+    return result;
+  }
+
+private:
+  std::vector<std::string> args_{};
+};
+
+command_line make_options_args(const std::size_t options,
+                               const std::size_t count) {
+  command_line cmd;
+  for (std::size_t i = 0; i != count; ++i) {
+    cmd.add("--" + option_name(i % options) + "=" + std::to_string(i));
+  }
+  return cmd;
+}
+
+command_line make_positional_args(const std::size_t count) {
+  command_line cmd;
+  for (std::size_t i = 0; i != count; ++i) {
+    cmd.add("file-" + std::to_string(i));
+  }
+  return cmd;
+}
+
+command_line make_unknown_args(const std::size_t count) {
+  command_line cmd;
+  for (std::size_t i = 0; i != count; ++i) {
+    cmd.add("--unknown-" + std::to_string(i));
+  }
+  return cmd;
+}
+
+/// Runs the function once and prints its time and peak heap usage.
+template <typename F>
+void report(const char* scenario,
+            const std::size_t options,
+            const std::size_t args,
+            F&& f) {
+  bench::reset_peak_allocations();
+  const auto before = bench::allocations();
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  const auto finish = std::chrono::steady_clock::now();
+  const auto after = bench::allocations();
+
+  const double ms =
+    std::chrono::duration<double, std::milli>(finish - start).count();
+  const auto items = args ? args : options;
+
+  std::printf("%-20s %10zu %10zu %12.1f %12.1f %12.1f\n",
+    scenario, options, args, ms,
+    static_cast<double>(after.peak - before.live) / (1024.0 * 1024.0),
+    ms * 1e6 / static_cast<double>(items));
+  std::fflush(stdout);
+}
+
+void run_parse(const char* scenario,
+               const cxxopts::options& options,
+               const std::size_t count,
+               const command_line& cmd) {
+  const auto argv = cmd.argv();
+
+  report(scenario, count, argv.size() - 1, [&] {
+    const auto result =
+      options.parse(static_cast<int>(argv.size()), argv.data());
+    bench::do_not_optimize(result);
+  });
+}
+
+std::vector<std::size_t> sizes(const std::size_t from, const std::size_t to) {
+  std::vector<std::size_t> result;
+  for (std::size_t n = from; n <= to; n *= 10) {
+    result.push_back(n);
+  }
+  return result;
+}
+
+} // namespace
+
+int main(int argc, const char* argv[]) {
+  cxxopts::options options(argv[0], " - run cxxopts scalability benchmarks");
+  options.add_options()
+    ("max-options", "Maximal number of options in a specification",
+      cxxopts::value<std::size_t>()->default_value("100000"), "N")
+    ("max-args", "Maximal number of arguments in a command line",
+      cxxopts::value<std::size_t>()->default_value("1000000"), "N")
+    ("h,help", "Print help");
+
+  try {
+    const auto result = options.parse(argc, argv);
+
+    if (result.count("help")) {
+      std::cout << options.help() << std::endl;
+      return 0;
+    }
+
+    const auto max_options = result["max-options"].as<std::size_t>();
+    const auto max_args = result["max-args"].as<std::size_t>();
+
+    std::printf("%-20s %10s %10s %12s %12s %12s\n",
+      "scenario", "options", "args", "time, ms", "peak, MiB", "ns/item");
+
+    for (const auto n : sizes(1000, max_options)) {
+      report("add_options", n, 0, [n] {
+        const auto spec = make_options(n);
+        bench::do_not_optimize(spec);
+      });
+
+      const auto spec = make_options(n);
+
+      report("help", n, 0, [&spec] {
+        const auto text = spec.help();
+        bench::do_not_optimize(text);
+      });
+      report("help/groups", n, 0, [&spec] {
+        const auto text = spec.help(spec.groups());
+        bench::do_not_optimize(text);
+      });
+    }
+
+    for (const auto n : sizes(1000, max_options)) {
+      auto spec = make_options(n);
+
+      for (const auto m : sizes(100000, max_args)) {
+        spec.allow_unrecognised_options(false).stop_on_positional(false);
+        run_parse("parse/options", spec, n, make_options_args(n, m));
+        run_parse("parse/positional", spec, n, make_positional_args(m));
+
+        spec.allow_unrecognised_options(true);
+        run_parse("parse/unrecognised", spec, n, make_unknown_args(m));
+
+        spec.allow_unrecognised_options(false).stop_on_positional(true);
+        run_parse("parse/stop", spec, n, make_positional_args(m));
+      }
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+      std::printf("max resident set size: %ld KiB\n",
+        static_cast<long>(usage.ru_maxrss));
+    }
+#endif
+  } catch (const cxxopts::option_error& e) {
+    std::cerr << "error parsing options: " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
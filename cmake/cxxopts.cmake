@@ -57,6 +57,14 @@ function(cxxopts_use_unicode)
     target_compile_definitions(cxxopts INTERFACE CXXOPTS_USE_UNICODE)
 endfunction()
 
+# Optionally, enable batch parsing which runs a pool of threads
+function(cxxopts_use_threads)
+    find_package(Threads REQUIRED)
+
+    target_link_libraries(cxxopts INTERFACE Threads::Threads)
+    target_compile_definitions(cxxopts INTERFACE CXXOPTS_USE_THREADS)
+endfunction()
+
 # Request C++11 without gnu extension for the whole project and enable more warnings
 macro(cxxopts_set_cxx_standard)
     if (CXXOPTS_CXX_STANDARD)
@@ -0,0 +1,147 @@
+/*
+
+Copyright (c) 2021 - 2023 Pavel Artemkin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+// Validates a file of command lines against a specification of a job.
+//
+// Each line of the file is a command line of the job. Arguments are separated
+// by whitespace and can be quoted with single or double quotes. Empty lines
+// and lines starting with '#' are skipped.
+
+#include <fstream>
+#include <iostream>
+
+#include "cxxopts.hpp"
+
+namespace {
+
+std::vector<std::string> split_command_line(const std::string& line) {
+  std::vector<std::string> args;
+  std::string current;
+  bool has_arg = false;
+  char quote = 0;
+
+  for (const char ch : line) {
+    if (quote) {
+      if (ch == quote) {
+        quote = 0;
+      } else {
+        current += ch;
+      }
+    } else if (ch == '\'' || ch == '"') {
+      quote = ch;
+      has_arg = true;
+    } else if (ch == ' ' || ch == '\t') {
+      if (has_arg) {
+        args.push_back(std::move(current));
+        current.clear();
+        has_arg = false;
+      }
+    } else {
+      current += ch;
+      has_arg = true;
+    }
+  }
+  if (has_arg) {
+    args.push_back(std::move(current));
+  }
+
+  return args;
+}
+
+cxxopts::options job_options() {
+  cxxopts::options options("job", " - a sample job");
+
+  options.add_options()
+    ("i,input", "Input files", cxxopts::value<std::vector<std::string>>())
+    ("o,output", "Output file", cxxopts::value<std::string>())
+    ("n,threads", "Number of threads", cxxopts::value<unsigned>())
+    ("l,limit", "Memory limit", cxxopts::value<uint64_t>())
+    ("r,ratio", "Sampling ratio", cxxopts::value<double>())
+    ("v,verbose", "Verbose output")
+    ("ids", "List of ids", cxxopts::value<std::vector<int64_t>>());
+  options.parse_positional("input");
+
+  return options;
+}
+
+} // namespace
+
+int main(int argc, const char* argv[]) {
+  cxxopts::options options(argv[0], " - validate command lines of a job");
+  options.positional_help("FILE").add_options()
+    ("j,jobs", "Number of threads", cxxopts::value<std::size_t>()
+      ->default_value("0"))
+    ("file", "File with command lines", cxxopts::value<std::string>())
+    ("h,help", "Print help");
+  options.parse_positional("file");
+
+  try {
+    const auto result = options.parse(argc, argv);
+
+    if (result.count("help") || !result.count("file")) {
+      std::cout << options.help() << std::endl;
+      return result.count("help") ? 0 : 1;
+    }
+
+    std::ifstream input(result["file"].as<std::string>());
+    if (!input) {
+      std::cerr << "cannot open " << result["file"].as<std::string>()
+                << std::endl;
+      return 1;
+    }
+
+    std::vector<std::vector<std::string>> commands;
+    std::vector<std::size_t> lines;
+    std::string line;
+    for (std::size_t number = 1; std::getline(input, line); ++number) {
+      if (line.empty() || line[0] == '#') {
+        continue;
+      }
+      commands.push_back(split_command_line(line));
+      commands.back().insert(commands.back().begin(), "job");
+      lines.push_back(number);
+    }
+
+    auto spec = job_options();
+    spec.compile();
+
+    const auto results =
+      spec.parse_batch(commands, result["jobs"].as<std::size_t>());
+
+    std::size_t failures = 0;
+    for (std::size_t i = 0; i != results.size(); ++i) {
+      if (results[i].failed) {
+        std::cout << lines[i] << ": " << results[i].error << std::endl;
+        ++failures;
+      }
+    }
+    std::cout << results.size() << " command lines, " << failures
+              << " failed" << std::endl;
+
+    return failures ? 2 : 0;
+  } catch (const cxxopts::option_error& e) {
+    std::cerr << "error parsing options: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -26,20 +26,30 @@ THE SOFTWARE.
 #ifndef CXXOPTS_HPP_INCLUDED
 #define CXXOPTS_HPP_INCLUDED
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <exception>
 #include <initializer_list>
 #include <iterator>
 #include <limits>
+#include <locale>
 #include <map>
 #include <memory>
+// Lazy conversion of values and the shared lookup table are serialized by
+// a mutex. Neither needs the thread library unless threads are used.
+#include <mutex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #ifdef __has_include
@@ -49,12 +59,44 @@ THE SOFTWARE.
 #   define CXXOPTS_HAS_OPTIONAL
 #  endif
 # endif
+# if __has_include(<string_view>)
+#  include <string_view>
+#  ifdef __cpp_lib_string_view
+#   define CXXOPTS_HAS_STRING_VIEW
+#  endif
+# endif
+# if __has_include(<charconv>)
+#  include <charconv>
+#  ifdef __cpp_lib_to_chars
+#   define CXXOPTS_HAS_FROM_CHARS
+#  endif
+# endif
+# if __has_include(<memory_resource>)
+#  include <memory_resource>
+#  ifdef __cpp_lib_memory_resource
+#   define CXXOPTS_HAS_MEMORY_RESOURCE
+#  endif
+# endif
+#endif
+
+// Options declared at compile time need string literals as template
+// arguments.
+#if defined(CXXOPTS_HAS_STRING_VIEW) && \
+  defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+# include <tuple>
+# define CXXOPTS_HAS_STATIC_OPTIONS
 #endif
 
 #ifdef CXXOPTS_USE_UNICODE
 # include <unicode/unistr.h>
 #endif
 
+// Batch parsing runs a pool of threads, so programs which use it should
+// link with the thread library.
+#ifdef CXXOPTS_USE_THREADS
+# include <thread>
+#endif
+
 #if __cplusplus >= 200809L
 # define CXXOPTS_NORETURN [[noreturn]]
 #else
@@ -73,6 +115,14 @@ THE SOFTWARE.
 # define CXXOPTS_CONSTEXPR
 #endif
 
+#if __cplusplus >= 201402L
+# define CXXOPTS_DEPRECATED(message) [[deprecated(message)]]
+#elif defined(__GNUC__)
+# define CXXOPTS_DEPRECATED(message) __attribute__((deprecated(message)))
+#else
+# define CXXOPTS_DEPRECATED(message)
+#endif
+
 // Disable exceptions if the specific compiler flags are set.
 #if !(defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND))
 # define CXXOPTS_NO_EXCEPTIONS
@@ -86,6 +136,17 @@ THE SOFTWARE.
 # define CXXOPTS_VECTOR_DELIMITER ','
 #endif
 
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || \
+  defined(_M_IX86) || defined(_M_X64) || defined(_M_ARM64)
+# define CXXOPTS_LITTLE_ENDIAN
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+  (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# include <emmintrin.h>
+# define CXXOPTS_HAS_SSE2
+#endif
+
 #define CXXOPTS__VERSION_MAJOR 5
 #define CXXOPTS__VERSION_MINOR 3
 #define CXXOPTS__VERSION_PATCH 1
@@ -115,6 +176,106 @@ using cxx_string = icu::UnicodeString;
 using cxx_string = std::string;
 #endif
 
+#ifdef CXXOPTS_HAS_STRING_VIEW
+using string_view = std::string_view;
+#else
+/**
+ * Non-owning reference to a sequence of characters.
+ *
+ * A subset of std::string_view for compilers without C++17 support.
+ */
+class string_view {
+public:
+  using const_iterator = const char*;
+  using size_type = std::size_t;
+
+  static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+  constexpr string_view() noexcept = default;
+
+  constexpr string_view(const char* str, const size_type len) noexcept
+    : data_(str)
+    , size_(len) {
+  }
+
+  string_view(const char* str) noexcept
+    : data_(str)
+    , size_(std::char_traits<char>::length(str)) {
+  }
+
+  string_view(const std::string& str) noexcept
+    : data_(str.data())
+    , size_(str.size()) {
+  }
+
+  constexpr const char* data() const noexcept {
+    return data_;
+  }
+
+  constexpr size_type size() const noexcept {
+    return size_;
+  }
+
+  constexpr bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  constexpr const_iterator begin() const noexcept {
+    return data_;
+  }
+
+  constexpr const_iterator end() const noexcept {
+    return data_ + size_;
+  }
+
+  constexpr const char& operator[](const size_type pos) const noexcept {
+    return data_[pos];
+  }
+
+  string_view substr(const size_type pos, const size_type len = npos) const {
+    assert(pos <= size_);
+    return string_view(data_ + pos, std::min(len, size_ - pos));
+  }
+
+  size_type find(const char ch, const size_type pos = 0) const noexcept {
+    for (size_type i = pos; i < size_; ++i) {
+      if (data_[i] == ch) {
+        return i;
+      }
+    }
+    return npos;
+  }
+
+  friend bool operator==(const string_view a, const string_view b) noexcept {
+    return a.size_ == b.size_ &&
+           std::char_traits<char>::compare(a.data_, b.data_, a.size_) == 0;
+  }
+
+  friend bool operator!=(const string_view a, const string_view b) noexcept {
+    return !(a == b);
+  }
+
+private:
+  const char* data_{nullptr};
+  size_type size_{0};
+};
+#endif
+
+namespace detail {
+
+inline std::string to_string(const string_view s) {
+  return std::string(s.data(), s.size());
+}
+
+inline const char* c_str(const std::string& s) noexcept {
+  return s.c_str();
+}
+
+inline const char* c_str(const char* s) noexcept {
+  return s;
+}
+
+} // namespace detail
 } // namespace cxxopts
 
 // when we ask cxxopts to use Unicode, help strings are processed using ICU,
@@ -131,6 +292,11 @@ static inline cxx_string to_local_string(std::string s) {
   return icu::UnicodeString::fromUTF8(std::move(s));
 }
 
+static inline cxx_string make_local_string(const string_view s) {
+  return icu::UnicodeString::fromUTF8(
+    icu::StringPiece(s.data(), static_cast<int32_t>(s.size())));
+}
+
 class unicode_string_iterator {
 public:
   using value_type = int32_t;
@@ -234,6 +400,10 @@ static inline T to_local_string(T&& t) {
   return std::forward<T>(t);
 }
 
+static inline cxx_string make_local_string(const string_view s) {
+  return cxx_string(s.data(), s.size());
+}
+
 CXXOPTS_CONSTEXPR
 static inline size_t string_length(const cxx_string& s) noexcept {
   return s.length();
@@ -400,6 +570,38 @@ CXXOPTS_NORETURN void throw_or_mimic(Args&&... args) {
  */
 
 namespace cxxopts {
+
+/**
+ * Notations of integer values accepted in addition to decimal.
+ */
+namespace notation {
+enum : unsigned {
+  /// Only decimal integers.
+  decimal = 0u,
+  /// Hexadecimal integers with 0x or 0X prefix.
+  hex = 1u << 0,
+  /// Binary integers with 0b or 0B prefix.
+  binary = 1u << 1,
+  /// Octal integers with leading zero.
+  octal = 1u << 2,
+};
+} // namespace notation
+
+/**
+ * Settings for customizing parser behaviour.
+ */
+struct parse_context {
+  char delimiter{CXXOPTS_VECTOR_DELIMITER};
+  /// Accepted notations of integer values.
+  unsigned notation{notation::hex};
+  /// Separator of groups of digits in integer values, or zero
+  /// if separators are not allowed.
+  char digit_separator{0};
+};
+
+template <typename T>
+struct value_parser;
+
 namespace detail {
 
 template <typename T, bool B>
@@ -447,78 +649,207 @@ CXXOPTS_CONSTEXPR inline bool checked_negate(R&,
   return false;
 }
 
-inline bool parse_uint64(const std::string& text,
-                         uint64_t& value,
-                         bool& negative) noexcept {
-  const char* p = text.c_str();
-  // String should not be empty.
-  if (*p == 0) {
+/**
+ * Converts eight decimal digits at once. Returns false if any
+ * of the characters is not a digit.
+ */
+inline bool parse_eight_digits(const char* p, uint64_t& value) noexcept {
+#ifdef CXXOPTS_LITTLE_ENDIAN
+  uint64_t chunk;
+  std::memcpy(&chunk, p, sizeof(chunk));
+  // Each byte is a digit if its high nibble is 3 and adding 6 to it
+  // does not carry into the high nibble.
+  if (((chunk & 0xF0F0F0F0F0F0F0F0u) |
+       (((chunk + 0x0606060606060606u) & 0xF0F0F0F0F0F0F0F0u) >> 4)) !=
+      0x3333333333333333u)
+  {
     return false;
   }
-  // Parse sign.
-  if (*p == '+') {
-    ++p;
-  } else if (*p == '-') {
-    negative = true;
+  chunk -= 0x3030303030303030u;
+  // Combine pairs, then quadruples of digits.
+  chunk = (chunk * 10u) + (chunk >> 8);
+  chunk = (((chunk & 0x000000FF000000FFu) * (100u + (uint64_t{1000000} << 32))) +
+           (((chunk >> 16) & 0x000000FF000000FFu) * (1u + (uint64_t{10000} << 32)))) >>
+          32;
+  value = chunk & 0xFFFFFFFFu;
+  return true;
+#else
+  uint64_t result = 0;
+  for (int i = 0; i != 8; ++i) {
+    if (p[i] < '0' || p[i] > '9') {
+      return false;
+    }
+    result = result * 10u + static_cast<uint64_t>(p[i] - '0');
+  }
+  value = result;
+  return true;
+#endif
+}
+
+inline bool parse_decimal(const char* p,
+                          const char* const end,
+                          uint64_t& value) noexcept {
+  // Leading zeros do not count towards the limit of digits.
+  while (end - p > 1 && *p == '0') {
     ++p;
   }
-  // Not an integer value.
-  if (*p == 0) {
+  // uint64_t holds any number of up to 19 decimal digits.
+  const auto length = end - p;
+  if (length > 20) {
     return false;
-  } else {
-    value = 0;
   }
-  // Hex number.
-  if (*p == '0' && *(p + 1) == 'x') {
-    p += 2;
-    if (*p == 0) {
+  const char* const last = length == 20 ? end - 1 : end;
+
+  uint64_t result = 0;
+  for (uint64_t chunk = 0; last - p >= 8; p += 8) {
+    if (!parse_eight_digits(p, chunk)) {
+      return false;
+    }
+    result = result * 100000000u + chunk;
+  }
+  for (; p != last; ++p) {
+    if (*p < '0' || *p > '9') {
       return false;
     }
-    for (; *p; ++p) {
-      uint64_t digit = 0;
-
-      if (*p >= '0' && *p <= '9') {
-        digit = static_cast<uint64_t>(*p - '0');
-      } else if (*p >= 'a' && *p <= 'f') {
-        digit = static_cast<uint64_t>(*p - 'a' + 10);
-      } else if (*p >= 'A' && *p <= 'F') {
-        digit = static_cast<uint64_t>(*p - 'A' + 10);
-      } else {
-        return false;
-      }
+    result = result * 10u + static_cast<uint64_t>(*p - '0');
+  }
+  // The twentieth digit may overflow.
+  if (last != end) {
+    if (*p < '0' || *p > '9') {
+      return false;
+    }
+    const auto digit = static_cast<uint64_t>(*p - '0');
+    if ((result > std::numeric_limits<uint64_t>::max() / 10u) ||
+        (result == std::numeric_limits<uint64_t>::max() / 10u && digit > 5))
+    {
+      return false;
+    }
+    result = result * 10u + digit;
+  }
+  value = result;
+  return true;
+}
 
-      const uint64_t next = value * 16u + digit;
-      if (value > next) {
-        return false;
-      } else {
-        value = next;
-      }
+inline bool parse_digits(const char* p,
+                         const char* const end,
+                         const unsigned base,
+                         uint64_t& value) noexcept {
+  uint64_t result = 0;
+  for (; p != end; ++p) {
+    unsigned digit = 0;
+
+    if (*p >= '0' && *p <= '9') {
+      digit = static_cast<unsigned>(*p - '0');
+    } else if (*p >= 'a' && *p <= 'f') {
+      digit = static_cast<unsigned>(*p - 'a' + 10);
+    } else if (*p >= 'A' && *p <= 'F') {
+      digit = static_cast<unsigned>(*p - 'A' + 10);
+    } else {
+      return false;
     }
-    // Decimal number.
-  } else {
-    for (; *p; ++p) {
-      uint64_t digit = 0;
+    if (digit >= base) {
+      return false;
+    }
+    if (result > (std::numeric_limits<uint64_t>::max() - digit) / base) {
+      return false;
+    }
+    result = result * base + digit;
+  }
+  value = result;
+  return true;
+}
 
-      if (*p >= '0' && *p <= '9') {
-        digit = static_cast<uint64_t>(*p - '0');
-      } else {
-        return false;
-      }
-      if ((value > std::numeric_limits<uint64_t>::max() / 10u) ||
-          (value == std::numeric_limits<uint64_t>::max() / 10u && digit > 5))
-      {
-        return false;
-      } else {
-        value = value * 10u + digit;
-      }
+/**
+ * Removes separators of groups of digits. Each separator should be
+ * placed between two digits.
+ */
+inline bool strip_separators(const string_view text,
+                             const char separator,
+                             std::string& digits) {
+  digits.reserve(text.size());
+  for (std::size_t i = 0; i != text.size(); ++i) {
+    if (text[i] != separator) {
+      digits += text[i];
+    } else if (digits.empty() || i + 1 == text.size() ||
+               text[i - 1] == separator)
+    {
+      return false;
     }
   }
   return true;
 }
 
-template <typename T,
-          typename std::enable_if<std::is_integral<T>::value>::type* = nullptr>
-inline void parse_value(const std::string& text, T& value) {
+inline bool parse_uint64(const parse_context& ctx,
+                         const string_view text,
+                         uint64_t& value,
+                         bool& negative) {
+  const char* p = text.data();
+  const char* const end = p + text.size();
+  // Parse sign.
+  if (p != end && (*p == '+' || *p == '-')) {
+    negative = *p == '-';
+    ++p;
+  }
+  // Not an integer value.
+  if (p == end) {
+    return false;
+  }
+  // Detect notation.
+  unsigned base = 10;
+  if (*p == '0' && end - p > 1) {
+    if ((p[1] == 'x' || p[1] == 'X') && (ctx.notation & notation::hex)) {
+      base = 16;
+      p += 2;
+    } else if ((p[1] == 'b' || p[1] == 'B') &&
+               (ctx.notation & notation::binary))
+    {
+      base = 2;
+      p += 2;
+    } else if (ctx.notation & notation::octal) {
+      base = 8;
+      p += 1;
+    }
+    // Prefix without digits.
+    if (p == end) {
+      return false;
+    }
+  }
+  // Drop separators of digits.
+  std::string digits;
+  if (ctx.digit_separator != 0 &&
+      std::memchr(p, ctx.digit_separator, static_cast<std::size_t>(end - p)))
+  {
+    if (!strip_separators(string_view(p, static_cast<std::size_t>(end - p)),
+                          ctx.digit_separator, digits))
+    {
+      return false;
+    }
+    p = digits.data();
+    return base == 10
+             ? parse_decimal(p, p + digits.size(), value)
+             : parse_digits(p, p + digits.size(), base, value);
+  }
+  return base == 10 ? parse_decimal(p, end, value)
+                    : parse_digits(p, end, base, value);
+}
+
+/// Integer types parsed as numbers. Values of type char are parsed
+/// as characters.
+template <typename T>
+struct is_integer
+  : std::integral_constant<bool,
+                           std::is_integral<T>::value &&
+                             !std::is_same<T, bool>::value &&
+                             !std::is_same<T, char>::value> {};
+
+/**
+ * Converts the text to an integer. Returns false if the text is not
+ * an integer or the integer is out of range of the type.
+ */
+template <typename T>
+bool convert_integer(const parse_context& ctx,
+                     const string_view text,
+                     T& value) {
   using US = typename std::make_unsigned<T>::type;
 
   uint64_t u64_result{0};
@@ -526,55 +857,226 @@ inline void parse_value(const std::string& text, T& value) {
   bool negative{false};
 
   // Parse text to the uint64_t value.
-  if (!parse_uint64(text, u64_result, negative)) {
-    throw_or_mimic<argument_incorrect_type>(text, "integer");
+  if (!parse_uint64(ctx, text, u64_result, negative)) {
+    return false;
   }
   // Check unsigned overflow.
   if (u64_result > std::numeric_limits<US>::max()) {
-    throw_or_mimic<argument_incorrect_type>(text, "integer");
+    return false;
   } else {
     result = static_cast<US>(u64_result);
   }
   // Check signed overflow.
   if (!check_signed_range<T>(result, negative)) {
-    throw_or_mimic<argument_incorrect_type>(text, "integer");
+    return false;
   }
   // Negate value.
   if (negative) {
-    if (!checked_negate<T>(
-          value, result,
-          std::integral_constant<bool, std::numeric_limits<T>::is_signed>()))
-    {
-      throw_or_mimic<argument_incorrect_type>(text, "integer");
+    return checked_negate<T>(
+      value, result,
+      std::integral_constant<bool, std::numeric_limits<T>::is_signed>());
+  }
+  value = static_cast<T>(result);
+  return true;
+}
+
+template <typename T>
+void parse_integer(const parse_context& ctx,
+                   const string_view text,
+                   T& value) {
+  if (!convert_integer(ctx, text, value)) {
+    throw_or_mimic<argument_incorrect_type>(to_string(text), "integer");
+  }
+}
+
+template <typename T,
+          typename std::enable_if<std::is_integral<T>::value>::type* = nullptr>
+inline void parse_value(const std::string& text, T& value) {
+  parse_integer(parse_context(), text, value);
+}
+
+/// Limits of exact conversion of decimal numbers.
+template <typename T>
+struct float_limits {
+  /// Largest mantissa which is represented exactly.
+  static constexpr uint64_t mantissa = uint64_t(1) << 53;
+  /// Largest power of ten which is represented exactly.
+  static constexpr int exponent = 22;
+};
+
+template <>
+struct float_limits<float> {
+  static constexpr uint64_t mantissa = uint64_t(1) << 24;
+  static constexpr int exponent = 10;
+};
+
+template <typename T>
+T power_of_ten(const int n) noexcept {
+  static const double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                  1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                  1e18, 1e19, 1e20, 1e21, 1e22};
+  // Powers within float_limits<T>::exponent are exact in T.
+  return static_cast<T>(powers[n]);
+}
+
+inline bool equal_nocase(const char* p,
+                         const char* const end,
+                         const char* word) noexcept {
+  for (; p != end && *word; ++p, ++word) {
+    if ((*p | 0x20) != *word) {
+      return false;
     }
-  } else {
-    value = static_cast<T>(result);
   }
+  return p == end && *word == 0;
+}
+
+/**
+ * Parses a floating point number in the form
+ * [+-](digits[.digits]|.digits)[(e|E)[+-]digits], or inf, infinity and nan
+ * in any case. The conversion does not depend on the current locale.
+ */
+template <typename T>
+bool parse_float(const string_view text, T& value) {
+  const char* p = text.data();
+  const char* const end = p + text.size();
+  bool negative = false;
+  // Parse sign.
+  if (p != end && (*p == '+' || *p == '-')) {
+    negative = *p == '-';
+    ++p;
+  }
+  if (p == end) {
+    return false;
+  }
+  // Special values.
+  if (*p != '.' && (*p < '0' || *p > '9')) {
+    if (equal_nocase(p, end, "inf") || equal_nocase(p, end, "infinity")) {
+      value = std::numeric_limits<T>::infinity();
+    } else if (equal_nocase(p, end, "nan")) {
+      value = std::numeric_limits<T>::quiet_NaN();
+    } else {
+      return false;
+    }
+    value = negative ? -value : value;
+    return true;
+  }
+#ifdef CXXOPTS_HAS_FROM_CHARS
+  const auto r = std::from_chars(p, end, value, std::chars_format::general);
+  if (r.ec != std::errc() || r.ptr != end) {
+    return false;
+  }
+  value = negative ? -value : value;
+  return true;
+#else
+  uint64_t mantissa = 0;
+  int significant = 0;
+  int exponent = 0;
+  bool truncated = false;
+  bool has_digits = false;
+
+  const auto add_digit = [&](const unsigned digit, const bool fraction) {
+    has_digits = true;
+    if (mantissa == 0 && digit == 0) {
+      // Leading zeros.
+      exponent -= fraction;
+    } else if (significant < 19) {
+      mantissa = mantissa * 10u + digit;
+      ++significant;
+      exponent -= fraction;
+    } else {
+      exponent += !fraction;
+      truncated = truncated || digit != 0;
+    }
+  };
+
+  for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+    add_digit(static_cast<unsigned>(*p - '0'), false);
+  }
+  if (p != end && *p == '.') {
+    for (++p; p != end && *p >= '0' && *p <= '9'; ++p) {
+      add_digit(static_cast<unsigned>(*p - '0'), true);
+    }
+  }
+  if (!has_digits) {
+    return false;
+  }
+  if (p != end && (*p == 'e' || *p == 'E')) {
+    bool negative_exponent = false;
+    int e = 0;
+
+    ++p;
+    if (p != end && (*p == '+' || *p == '-')) {
+      negative_exponent = *p == '-';
+      ++p;
+    }
+    if (p == end) {
+      return false;
+    }
+    for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+      // Large exponents overflow or underflow anyway.
+      if (e < 100000) {
+        e = e * 10 + (*p - '0');
+      }
+    }
+    exponent += negative_exponent ? -e : e;
+  }
+  // Trailing characters.
+  if (p != end) {
+    return false;
+  }
+  // Both the mantissa and the power of ten are exact, so a single
+  // multiplication or division gives the correctly rounded result.
+  if (!truncated && mantissa <= float_limits<T>::mantissa &&
+      exponent >= -float_limits<T>::exponent &&
+      exponent <= float_limits<T>::exponent)
+  {
+    value = static_cast<T>(mantissa);
+    if (exponent < 0) {
+      value /= power_of_ten<T>(-exponent);
+    } else {
+      value *= power_of_ten<T>(exponent);
+    }
+    value = negative ? -value : value;
+    return true;
+  }
+  // Other values are converted by the stream in the classic locale.
+  std::istringstream in{to_string(text)};
+  in.imbue(std::locale::classic());
+  in >> value;
+  return !in.fail();
+#endif
 }
 
 inline void parse_value(const std::string& text, float& value) {
-  value = std::stof(text);
+  if (!parse_float(text, value)) {
+    throw_or_mimic<argument_incorrect_type>(text, "float");
+  }
 }
 
 inline void parse_value(const std::string& text, double& value) {
-  value = std::stod(text);
+  if (!parse_float(text, value)) {
+    throw_or_mimic<argument_incorrect_type>(text, "float");
+  }
 }
 
 inline void parse_value(const std::string& text, long double& value) {
-  value = std::stold(text);
+  if (!parse_float(text, value)) {
+    throw_or_mimic<argument_incorrect_type>(text, "float");
+  }
 }
 
-inline void parse_value(const std::string& text, bool& value) {
+inline bool convert_bool(const string_view text, bool& value) noexcept {
   switch (text.size()) {
     case 1: {
       const char ch = text[0];
       if (ch == '1' || ch == 't' || ch == 'T') {
         value = true;
-        return;
+        return true;
       }
       if (ch == '0' || ch == 'f' || ch == 'F') {
         value = false;
-        return;
+        return true;
       }
       break;
     }
@@ -583,7 +1085,7 @@ inline void parse_value(const std::string& text, bool& value) {
           (text[1] == 'r' && text[2] == 'u' && text[3] == 'e'))
       {
         value = true;
-        return;
+        return true;
       }
       break;
     case 5:
@@ -592,11 +1094,17 @@ inline void parse_value(const std::string& text, bool& value) {
            text[4] == 'e'))
       {
         value = false;
-        return;
+        return true;
       }
       break;
   }
-  throw_or_mimic<argument_incorrect_type>(text, "bool");
+  return false;
+}
+
+inline void parse_value(const std::string& text, bool& value) {
+  if (!convert_bool(text, value)) {
+    throw_or_mimic<argument_incorrect_type>(text, "bool");
+  }
 }
 
 inline void parse_value(const std::string& text, char& c) {
@@ -633,14 +1141,309 @@ void parse_value(const std::string& text, std::optional<T>& value) {
 }
 #endif
 
-} // namespace detail
+inline int count_bits(uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(value);
+#else
+  int n = 0;
+  for (; value != 0; value &= value - 1) {
+    ++n;
+  }
+  return n;
+#endif
+}
+
+inline int count_trailing_zeros(const uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(value);
+#else
+  int n = 0;
+  for (uint64_t v = value; (v & 1u) == 0; v >>= 1) {
+    ++n;
+  }
+  return n;
+#endif
+}
 
 /**
- * Settings for customizing parser behaviour.
+ * Returns a mask of positions of the character in a block of 64 bytes.
  */
-struct parse_context {
-  char delimiter{CXXOPTS_VECTOR_DELIMITER};
-};
+inline uint64_t match_block(const char* p, const char ch) noexcept {
+#ifdef CXXOPTS_HAS_SSE2
+  const __m128i pattern = _mm_set1_epi8(ch);
+  uint64_t mask = 0;
+  for (int i = 0; i != 4; ++i) {
+    const __m128i block =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+    const auto bits = static_cast<uint32_t>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)));
+    mask |= static_cast<uint64_t>(bits) << (16 * i);
+  }
+  return mask;
+#else
+  constexpr uint64_t low = 0x7F7F7F7F7F7F7F7Fu;
+  const uint64_t pattern = 0x0101010101010101u * static_cast<unsigned char>(ch);
+  uint64_t mask = 0;
+  for (int i = 0; i != 8; ++i) {
+    uint64_t chunk;
+    std::memcpy(&chunk, p + 8 * i, sizeof(chunk));
+    chunk ^= pattern;
+    const uint64_t zeros = ~(((chunk & low) + low) | chunk | low);
+# ifdef CXXOPTS_LITTLE_ENDIAN
+    // Gather the high bits of the bytes into the top byte.
+    mask |= (((zeros >> 7) * 0x0102040810204080u) >> 56) << (8 * i);
+# else
+    for (int j = 0; j != 8; ++j) {
+      if (p[8 * i + j] == ch) {
+        mask |= uint64_t(1) << (8 * i + j);
+      }
+    }
+    static_cast<void>(zeros);
+# endif
+  }
+  return mask;
+#endif
+}
+
+/**
+ * Calls the function for each field of the delimited text until the
+ * function returns false. Delimiters are located a block at a time.
+ * A trailing delimiter does not start a field, and empty text is
+ * a single empty field. Returns false if the iteration has been stopped.
+ *
+ * Before fields of a block are passed to the function, their number is
+ * passed to reserve, so storage can be allocated without a separate
+ * pass over the text. For the first block of a long text, the number is
+ * extrapolated to the whole text.
+ */
+template <typename F, typename R>
+bool for_each_field(const string_view text,
+                    const char delimiter,
+                    F&& f,
+                    R&& reserve) {
+  if (text.empty()) {
+    reserve(std::size_t(1));
+    return f(text);
+  }
+
+  const char* p = text.data();
+  const char* const end = p + text.size();
+  const char* start = p;
+  char tail[64];
+
+  for (const char* block = p; p != end; block = p) {
+    const auto size =
+      std::min<std::size_t>(64, static_cast<std::size_t>(end - p));
+    // The last block is padded with a character which is not a delimiter.
+    if (size != 64) {
+      std::memset(tail, static_cast<unsigned char>(~delimiter), sizeof(tail));
+      std::memcpy(tail, p, size);
+    }
+    uint64_t mask = match_block(size == 64 ? p : tail, delimiter);
+    p += size;
+
+    std::size_t count = static_cast<std::size_t>(count_bits(mask)) +
+                        (p == end && end[-1] != delimiter);
+    if (block == text.data()) {
+      count *= (text.size() + 63) / 64;
+    }
+    reserve(count);
+    for (; mask != 0; mask &= mask - 1) {
+      const char* const d = block + count_trailing_zeros(mask);
+      if (!f(string_view(start, static_cast<std::size_t>(d - start)))) {
+        return false;
+      }
+      start = d + 1;
+    }
+  }
+  if (start != end) {
+    return f(string_view(start, static_cast<std::size_t>(end - start)));
+  }
+  return true;
+}
+
+template <typename F>
+bool for_each_field(const string_view text, const char delimiter, F&& f) {
+  return for_each_field(text, delimiter, std::forward<F>(f),
+                        [](std::size_t) {});
+}
+
+/**
+ * Makes room for more elements. Growth stays geometric, as the elements
+ * of a list may be added by many calls.
+ */
+template <typename T>
+void reserve_more(std::vector<T>& value, const std::size_t count) {
+  if (value.capacity() - value.size() < count) {
+    value.reserve(std::max(value.size() + count, value.capacity() * 2));
+  }
+}
+
+/// Detects parsers which are not customized by the user.
+template <typename T, typename = void>
+struct is_builtin_parser : std::false_type {};
+
+template <typename T>
+struct is_builtin_parser<
+  T,
+  typename std::enable_if<value_parser<T>::is_builtin::value>::type>
+  : std::true_type {};
+
+/// Numbers which are parsed directly from the text of a list.
+template <typename T>
+struct is_number
+  : std::integral_constant<bool,
+                           is_integer<T>::value ||
+                             std::is_floating_point<T>::value> {};
+
+template <typename T>
+void parse_number(const parse_context& ctx,
+                  const string_view text,
+                  T& value,
+                  std::true_type /* integer */) {
+  parse_integer(ctx, text, value);
+}
+
+template <typename T>
+void parse_number(const parse_context&,
+                  const string_view text,
+                  T& value,
+                  std::false_type /* integer */) {
+  if (!parse_float(text, value)) {
+    throw_or_mimic<argument_incorrect_type>(to_string(text), "float");
+  }
+}
+
+template <typename T>
+void parse_number(const parse_context& ctx, const string_view text, T& value) {
+  parse_number(ctx, text, value, is_integer<T>());
+}
+
+// Conversions which report errors through the returned value instead
+// of exceptions.
+
+template <typename T,
+          typename std::enable_if<is_integer<T>::value>::type* = nullptr>
+bool try_parse_value(const parse_context& ctx,
+                     const string_view text,
+                     T& value) {
+  return convert_integer(ctx, text, value);
+}
+
+template <typename T,
+          typename std::enable_if<std::is_floating_point<T>::value>::type* =
+            nullptr>
+bool try_parse_value(const parse_context&, const string_view text, T& value) {
+  return parse_float(text, value);
+}
+
+inline bool try_parse_value(const parse_context&,
+                            const string_view text,
+                            bool& value) {
+  return convert_bool(text, value);
+}
+
+inline bool try_parse_value(const parse_context&,
+                            const string_view text,
+                            char& value) {
+  if (text.size() != 1) {
+    return false;
+  }
+  value = text[0];
+  return true;
+}
+
+inline bool try_parse_value(const parse_context&,
+                            const string_view text,
+                            std::string& value) {
+  value.assign(text.data(), text.size());
+  return true;
+}
+
+template <typename T>
+bool try_parse_value(const parse_context& ctx,
+                     const string_view text,
+                     std::vector<T>& value) {
+  const auto parse_item = [&](const string_view item) {
+    T v{};
+    if (!try_parse_value(ctx, item, v)) {
+      return false;
+    }
+    value.push_back(std::move(v));
+    return true;
+  };
+  return for_each_field(text, ctx.delimiter, parse_item,
+                        [&value](const std::size_t count) {
+                          reserve_more(value, count);
+                        });
+}
+
+/// Types with a conversion which does not throw.
+template <typename T>
+struct has_try_parse
+  : std::integral_constant<bool,
+                           is_builtin_parser<T>::value &&
+                             (is_number<T>::value ||
+                              std::is_same<T, bool>::value ||
+                              std::is_same<T, char>::value ||
+                              std::is_same<T, std::string>::value)> {};
+
+template <typename T>
+struct has_try_parse<std::vector<T>>
+  : std::integral_constant<bool,
+                           is_builtin_parser<std::vector<T>>::value &&
+                             !value_parser<T>::is_container &&
+                             has_try_parse<T>::value> {};
+
+// Conversions of the builtin parsers which read the text in place, so
+// the text is not copied into a std::string. Errors are reported as by
+// value_parser.
+
+template <typename T,
+          typename std::enable_if<is_number<T>::value>::type* = nullptr>
+void parse_text(const parse_context& ctx, const string_view text, T& value) {
+  parse_number(ctx, text, value);
+}
+
+inline void parse_text(const parse_context&,
+                       const string_view text,
+                       bool& value) {
+  if (!convert_bool(text, value)) {
+    throw_or_mimic<argument_incorrect_type>(to_string(text), "bool");
+  }
+}
+
+inline void parse_text(const parse_context&,
+                       const string_view text,
+                       char& value) {
+  if (text.size() != 1) {
+    throw_or_mimic<argument_incorrect_type>(to_string(text), "char");
+  }
+  value = text[0];
+}
+
+inline void parse_text(const parse_context&,
+                       const string_view text,
+                       std::string& value) {
+  value.assign(text.data(), text.size());
+}
+
+template <typename T>
+void parse_text(const parse_context& ctx,
+                const string_view text,
+                std::vector<T>& value) {
+  for_each_field(
+    text, ctx.delimiter,
+    [&](const string_view field) {
+      T v{};
+      parse_text(ctx, field, v);
+      value.push_back(std::move(v));
+      return true;
+    },
+    [&value](const std::size_t count) { reserve_more(value, count); });
+}
+
+} // namespace detail
 
 /**
  * A parser for values of type T.
@@ -650,8 +1453,25 @@ struct value_parser {
   using value_type = T;
   /// By default, value cannot act as a container.
   static constexpr bool is_container = false;
+  /// The parser is provided by the library.
+  using is_builtin = std::true_type;
+
+  void parse(const parse_context& ctx, const std::string& text, T& value) {
+    parse(ctx, text, value, detail::is_integer<T>());
+  }
+
+private:
+  void parse(const parse_context& ctx,
+             const std::string& text,
+             T& value,
+             std::true_type) {
+    detail::parse_integer(ctx, text, value);
+  }
 
-  void parse(const parse_context&, const std::string& text, T& value) {
+  void parse(const parse_context&,
+             const std::string& text,
+             T& value,
+             std::false_type) {
     detail::parse_value(text, value);
   }
 };
@@ -661,6 +1481,8 @@ struct value_parser<std::vector<T>> {
   using value_type = T;
   /// Value of type std::vector<T> can act as container.
   static constexpr bool is_container = true;
+  /// The parser is provided by the library.
+  using is_builtin = std::true_type;
 
   void parse(const parse_context& ctx,
              const std::string& text,
@@ -672,24 +1494,85 @@ struct value_parser<std::vector<T>> {
         !value_parser<typename parser_type::value_type>::is_container,
       "dimensions of a container type should not exceed 2");
 
+    parse(ctx, text, value,
+          std::integral_constant<bool, detail::is_number<T>::value &&
+                                         detail::is_builtin_parser<T>::value>());
+  }
+
+private:
+  /// Lists of numbers are parsed in place without copying of elements.
+  void parse(const parse_context& ctx,
+             const std::string& text,
+             std::vector<T>& value,
+             std::true_type) {
+    detail::for_each_field(
+      text, ctx.delimiter,
+      [&](const string_view field) {
+        value.push_back(parse_element(ctx, field));
+        return true;
+      },
+      [&value](const std::size_t count) { detail::reserve_more(value, count); });
+  }
+
+  static T parse_element(const parse_context& ctx, const string_view text) {
+    T v{};
+    detail::parse_number(ctx, text, v);
+    return v;
+  }
+
+  void parse(const parse_context& ctx,
+             const std::string& text,
+             std::vector<T>& value,
+             std::false_type) {
+    using parser_type = value_parser<T>;
+
     auto parse_item = [&ctx](const std::string& txt) {
       T v;
       parser_type().parse(ctx, txt, v);
       return v;
     };
 
-    if (text.empty() || parser_type::is_container) {
+    // Elements which are lists themselves take the whole text.
+    if (parser_type::is_container) {
       value.push_back(parse_item(text));
-    } else {
-      std::istringstream in{text};
-      std::string token;
-      while (!in.eof() && std::getline(in, token, ctx.delimiter)) {
-        value.push_back(parse_item(token));
-      }
+      return;
     }
+
+    std::string token;
+    detail::for_each_field(
+      text, ctx.delimiter,
+      [&](const string_view field) {
+        token.assign(field.data(), field.size());
+        value.push_back(parse_item(token));
+        return true;
+      },
+      [&value](const std::size_t count) { detail::reserve_more(value, count); });
   }
 };
 
+/**
+ * Parses a delimited list of numbers and writes them to the output
+ * iterator. Returns the iterator past the last written number.
+ * Fields are split as for values of type std::vector<T>, so empty
+ * text is a single empty field, which is not a number.
+ */
+template <typename T, typename OutputIt>
+OutputIt parse_list(const string_view text,
+                    OutputIt out,
+                    const parse_context& ctx = parse_context()) {
+  static_assert(detail::is_number<T>::value,
+                "only lists of numbers can be parsed");
+
+  detail::for_each_field(text, ctx.delimiter, [&](const string_view field) {
+    T value{};
+    detail::parse_number(ctx, field, value);
+    *out = value;
+    ++out;
+    return true;
+  });
+  return out;
+}
+
 } // namespace cxxopts
 
 /**@}*/
@@ -702,6 +1585,154 @@ struct value_parser<std::vector<T>> {
 namespace cxxopts {
 namespace detail {
 
+/// Allocator of the containers of a parse result. With memory resources
+/// available, the result may be backed by a resource given by the caller.
+#ifdef CXXOPTS_HAS_MEMORY_RESOURCE
+template <typename T>
+using result_allocator = std::pmr::polymorphic_allocator<T>;
+#else
+template <typename T>
+using result_allocator = std::allocator<T>;
+#endif
+
+template <typename T>
+using result_vector = std::vector<T, result_allocator<T>>;
+
+using result_string =
+  std::basic_string<char, std::char_traits<char>, result_allocator<char>>;
+
+template <typename T>
+void reset_value(T& value) {
+  value = T();
+}
+
+/**
+ * Converts text to the value so that the value stays unchanged if
+ * the conversion fails. The value is converted into a temporary.
+ */
+template <typename T, typename Convert>
+bool convert_or_keep(T& value, Convert&& convert) {
+  T temp{};
+  if (!convert(temp)) {
+    return false;
+  }
+  value = std::move(temp);
+  return true;
+}
+
+/// Elements of a list are added in place and are dropped on failure.
+template <typename T, typename Convert>
+bool convert_or_keep(std::vector<T>& value, Convert&& convert) {
+  const auto size = value.size();
+  if (convert(value)) {
+    return true;
+  }
+  value.erase(value.begin() + static_cast<std::ptrdiff_t>(size), value.end());
+  return false;
+}
+
+template <typename T>
+void reset_value(std::vector<T>& value) {
+  value.clear();
+}
+
+inline void reset_value(std::string& value) {
+  value.clear();
+}
+
+/// Assigns a kept default or implicit value. Lists are extended, as when
+/// the value is parsed from text.
+template <typename T>
+void assign_value(T& target, const T& value) {
+  target = value;
+}
+
+template <typename T>
+void assign_value(std::vector<T>& target, const std::vector<T>& value) {
+  target.insert(target.end(), value.begin(), value.end());
+}
+
+/// Values of types which are either not containers or are vectors
+/// can be kept in converted form.
+template <typename T>
+struct is_cacheable
+  : std::integral_constant<bool, !value_parser<T>::is_container> {};
+
+template <typename T>
+struct is_cacheable<std::vector<T>> : std::true_type {};
+
+/// Distinguishes text of a value from a value of the option type.
+template <typename T>
+struct is_text
+  : std::integral_constant<
+      bool,
+      !std::is_same<std::nullptr_t, typename std::remove_cv<
+                                      typename std::remove_reference<T>::type>::type>::value &&
+        std::is_constructible<std::string, T>::value> {};
+
+template <typename T>
+void write_value(std::ostringstream& out, const T& value, std::false_type) {
+  out << value;
+}
+
+/// Writes the shortest text which is read back as the same number.
+template <typename T>
+void write_value(std::ostringstream& out, const T value, std::true_type) {
+  for (int precision = std::numeric_limits<T>::digits10;; ++precision) {
+    out.str(std::string());
+    out.precision(precision);
+    out << value;
+
+    std::istringstream in(out.str());
+    in.imbue(std::locale::classic());
+    T parsed{};
+    in >> parsed;
+    if (parsed == value ||
+        precision >= std::numeric_limits<T>::max_digits10)
+    {
+      return;
+    }
+  }
+}
+
+/// Formats a value for the help text.
+template <typename T>
+std::string format_value(const parse_context&, const T& value) {
+  std::ostringstream out;
+  out.imbue(std::locale::classic());
+  write_value(out, value, std::is_floating_point<T>());
+  return out.str();
+}
+
+inline std::string format_value(const parse_context&, const std::string& value) {
+  return value;
+}
+
+inline std::string format_value(const parse_context&, const bool value) {
+  return value ? "true" : "false";
+}
+
+template <typename T>
+std::string format_value(const parse_context& ctx,
+                         const std::vector<T>& value) {
+  std::string result;
+  for (std::size_t i = 0; i != value.size(); ++i) {
+    if (i != 0) {
+      result += ctx.delimiter;
+    }
+    result += format_value(ctx, value[i]);
+  }
+  return result;
+}
+
+#ifdef CXXOPTS_HAS_OPTIONAL
+template <typename T>
+std::string format_value(const parse_context& ctx,
+                         const std::optional<T>& value) {
+  return value ? format_value(ctx, *value) : std::string();
+}
+#endif
+
 #if defined(__GNUC__)
 // GNU GCC with -Weffc++ will issue a warning regarding the upcoming class, we
 // want to silence it: warning: base class 'class
@@ -765,18 +1796,37 @@ public:
    * to a string, that leads to runtime error.
    */
   template <typename T>
-  typename std::enable_if<
-    !std::is_same<std::nullptr_t, typename std::remove_cv<T>::type>::value,
-    std::shared_ptr<value_base>>::type
+  typename std::enable_if<is_text<T>::value, std::shared_ptr<value_base>>::type
   default_value(T&& value) {
     default_ = true;
     default_value_.assign(std::forward<T>(value));
+    default_cached_ = false;
+    default_typed_ = false;
     return shared_from_this();
   }
 
   /** Sets delimiter for list values. */
   std::shared_ptr<value_base> delimiter(const char del) {
     parse_ctx_.delimiter = del;
+    // Conversion of list values depends on the delimiter.
+    update_context();
+    return shared_from_this();
+  }
+
+  /**
+   * Sets accepted notations of integer values, as a combination
+   * of cxxopts::notation flags.
+   */
+  std::shared_ptr<value_base> integer_notation(const unsigned flags) {
+    parse_ctx_.notation = flags;
+    update_context();
+    return shared_from_this();
+  }
+
+  /** Sets separator of groups of digits in integer values. */
+  std::shared_ptr<value_base> digit_separator(const char separator) {
+    parse_ctx_.digit_separator = separator;
+    update_context();
     return shared_from_this();
   }
 
@@ -798,12 +1848,12 @@ public:
    * to a string, that leads to runtime error.
    */
   template <typename T>
-  typename std::enable_if<
-    !std::is_same<std::nullptr_t, typename std::remove_cv<T>::type>::value,
-    std::shared_ptr<value_base>>::type
+  typename std::enable_if<is_text<T>::value, std::shared_ptr<value_base>>::type
   implicit_value(T&& value) {
     implicit_ = true;
     implicit_value_.assign(std::forward<T>(value));
+    implicit_cached_ = false;
+    implicit_typed_ = false;
     return shared_from_this();
   }
 
@@ -812,6 +1862,8 @@ public:
     no_value_ = false;
     implicit_ = false;
     implicit_value_.clear();
+    implicit_cached_ = false;
+    implicit_typed_ = false;
     return shared_from_this();
   }
 
@@ -831,14 +1883,79 @@ public:
     return do_is_container();
   }
 
+  /** Returns whether the value is bound to a user variable. */
+  bool is_bound() const noexcept {
+    return do_is_bound();
+  }
+
+  /**
+   * Creates a copy of the value with the same settings but with
+   * its own storage. A value bound to a variable shares the variable.
+   */
+  std::shared_ptr<value_base> clone() const {
+    return do_clone();
+  }
+
+  /**
+   * Creates a copy of the value as clone() does, placing the copy and
+   * its storage in memory obtained from the allocator.
+   */
+  std::shared_ptr<value_base> clone(
+    const detail::result_allocator<char>& alloc) const {
+    return do_allocate_clone(alloc);
+  }
+
   /** Parses the given text into the value. */
-  void parse(const std::string& text) {
+  void parse(const string_view text) {
     return do_parse(parse_ctx_, text);
   }
 
+  /**
+   * Parses the given text into the value. Returns false instead of
+   * throwing if the text is not a valid value.
+   */
+  bool try_parse(const string_view text) {
+    return do_try_parse(parse_ctx_, text);
+  }
+
   /** Parses the default value. */
-  void parse() {
-    return do_parse(parse_ctx_, default_value_);
+  void parse_default() {
+    if (default_cached_) {
+      do_assign_default();
+    } else {
+      do_parse(parse_ctx_, default_value_);
+    }
+  }
+
+  /** Parses the implicit value. */
+  void parse_implicit() {
+    if (implicit_cached_) {
+      do_assign_implicit();
+    } else {
+      do_parse(parse_ctx_, implicit_value_);
+    }
+  }
+
+  /**
+   * Converts the default and the implicit values once, so that later
+   * parses copy them instead of converting the text again. Reports
+   * invalid values.
+   */
+  void prepare() {
+    if (default_ && !default_cached_) {
+      default_cached_ = do_cache_default(parse_ctx_, default_value_);
+    }
+    if (implicit_ && !implicit_cached_) {
+      implicit_cached_ = do_cache_implicit(parse_ctx_, implicit_value_);
+    }
+  }
+
+  /**
+   * Resets the owned storage to the initial state. Capacity of
+   * the storage is kept whenever possible.
+   */
+  void reset() {
+    do_reset();
   }
 
 protected:
@@ -846,14 +1963,64 @@ protected:
 
   virtual bool do_is_container() const noexcept = 0;
 
-  virtual void do_parse(const parse_context& ctx, const std::string& text) = 0;
+  virtual bool do_is_bound() const noexcept = 0;
 
-  void set_default_and_implicit(const bool set_default) {
-    if (is_boolean()) {
-      if (set_default) {
-        default_ = true;
-        default_value_ = "false";
-      }
+  virtual std::shared_ptr<value_base> do_clone() const = 0;
+
+  virtual std::shared_ptr<value_base> do_allocate_clone(
+    const detail::result_allocator<char>&) const {
+    return do_clone();
+  }
+
+  virtual void do_reset() = 0;
+
+  virtual void do_parse(const parse_context& ctx, string_view text) = 0;
+
+  virtual bool do_try_parse(const parse_context& ctx, string_view text) = 0;
+
+  /// Converts the text of the default value and keeps the result.
+  /// Returns false if the value cannot be kept.
+  virtual bool do_cache_default(const parse_context& ctx,
+                                const std::string& text) = 0;
+
+  virtual bool do_cache_implicit(const parse_context& ctx,
+                                 const std::string& text) = 0;
+
+  /// Sets the kept default value.
+  virtual void do_assign_default() = 0;
+
+  virtual void do_assign_implicit() = 0;
+
+  /// Formats the kept default value for the help text.
+  virtual std::string do_format_default(const parse_context& ctx) const = 0;
+
+  virtual std::string do_format_implicit(const parse_context& ctx) const = 0;
+
+  /// Sets the text of the default value given by the value of the type.
+  void set_typed_default(std::string text) {
+    default_ = true;
+    default_value_ = std::move(text);
+    default_cached_ = true;
+    default_typed_ = true;
+  }
+
+  void set_typed_implicit(std::string text) {
+    implicit_ = true;
+    implicit_value_ = std::move(text);
+    implicit_cached_ = true;
+    implicit_typed_ = true;
+  }
+
+  const parse_context& context() const noexcept {
+    return parse_ctx_;
+  }
+
+  void set_default_and_implicit(const bool set_default) {
+    if (is_boolean()) {
+      if (set_default) {
+        default_ = true;
+        default_value_ = "false";
+      }
       implicit_ = true;
       implicit_value_ = "true";
       no_value_ = true;
@@ -879,6 +2046,32 @@ private:
   bool implicit_{false};
   /// There should be no value for the option.
   bool no_value_{false};
+  /// The default value has been converted and kept.
+  bool default_cached_{false};
+  /// The implicit value has been converted and kept.
+  bool implicit_cached_{false};
+  /// The default value was given as a value of the type, not as text.
+  bool default_typed_{false};
+  /// The implicit value was given as a value of the type, not as text.
+  bool implicit_typed_{false};
+
+  /**
+   * Values given as text are converted again with the new settings of
+   * the parser. Values given as values of the type are kept, and only
+   * their text is formatted again.
+   */
+  void update_context() {
+    if (default_typed_) {
+      default_value_ = do_format_default(parse_ctx_);
+    } else {
+      default_cached_ = false;
+    }
+    if (implicit_typed_) {
+      implicit_value_ = do_format_implicit(parse_ctx_);
+    } else {
+      implicit_cached_ = false;
+    }
+  }
 };
 #if defined(__GNUC__)
 # pragma GCC diagnostic pop
@@ -889,9 +2082,10 @@ class basic_value : public value_base {
   using parser_type = value_parser<T>;
 
 public:
+  // Storage is inline, so the prototype in a specification can be parsed
+  // into as well; clones made for parse results use their own.
   basic_value()
-    : result_(new T{})
-    , store_(result_.get()) {
+    : store_(&result_) {
     set_default_and_implicit(true);
   }
 
@@ -904,6 +2098,78 @@ public:
     return *store_;
   }
 
+  // Setters of value_base which keep the type of the value, so that
+  // the result of a chain of setters can be passed where the type matters.
+
+  template <typename U>
+  typename std::enable_if<is_text<U>::value, std::shared_ptr<basic_value>>::type
+  default_value(U&& value) {
+    value_base::default_value(std::forward<U>(value));
+    return self();
+  }
+
+  /** Sets default value of the option type. */
+  std::shared_ptr<basic_value> default_value(const T& value) {
+    format_ = &format_typed;
+    set_typed_default(format_value(context(), value));
+    default_cache_ = std::make_shared<const T>(value);
+    return self();
+  }
+
+  // Rejects nullptr, which would otherwise convert to a std::string.
+  std::shared_ptr<basic_value> default_value(std::nullptr_t) = delete;
+
+  std::shared_ptr<basic_value> delimiter(const char del) {
+    value_base::delimiter(del);
+    return self();
+  }
+
+  std::shared_ptr<basic_value> integer_notation(const unsigned flags) {
+    value_base::integer_notation(flags);
+    return self();
+  }
+
+  std::shared_ptr<basic_value> digit_separator(const char separator) {
+    value_base::digit_separator(separator);
+    return self();
+  }
+
+  template <typename U>
+  typename std::enable_if<
+    !std::is_same<std::nullptr_t, typename std::remove_cv<U>::type>::value,
+    std::shared_ptr<basic_value>>::type
+  env(U&& var) {
+    value_base::env(std::forward<U>(var));
+    return self();
+  }
+
+  template <typename U>
+  typename std::enable_if<is_text<U>::value, std::shared_ptr<basic_value>>::type
+  implicit_value(U&& value) {
+    value_base::implicit_value(std::forward<U>(value));
+    return self();
+  }
+
+  /** Sets implicit value of the option type. */
+  std::shared_ptr<basic_value> implicit_value(const T& value) {
+    format_ = &format_typed;
+    set_typed_implicit(format_value(context(), value));
+    implicit_cache_ = std::make_shared<const T>(value);
+    return self();
+  }
+
+  std::shared_ptr<basic_value> implicit_value(std::nullptr_t) = delete;
+
+  std::shared_ptr<basic_value> no_implicit_value() {
+    value_base::no_implicit_value();
+    return self();
+  }
+
+  std::shared_ptr<basic_value> no_value(const bool on = true) {
+    value_base::no_value(on);
+    return self();
+  }
+
 protected:
   bool do_is_boolean() const noexcept final override {
     return std::is_same<T, bool>::value;
@@ -913,17 +2179,151 @@ protected:
     return parser_type::is_container;
   }
 
-  void do_parse(const parse_context& ctx, const std::string& text) override {
-    parser_type().parse(ctx, text, *store_);
+  bool do_is_bound() const noexcept final override {
+    return store_ != nullptr && store_ != &result_;
+  }
+
+  std::shared_ptr<value_base> do_clone() const override {
+    return std::make_shared<basic_value>(*this, clone_tag());
+  }
+
+  std::shared_ptr<value_base> do_allocate_clone(
+    const result_allocator<char>& alloc) const override {
+    return std::allocate_shared<basic_value>(
+      result_allocator<basic_value>(alloc), *this, clone_tag());
+  }
+
+  void do_reset() override {
+    // Values bound to a variable are owned by the user.
+    if (store_ == &result_) {
+      reset_value(result_);
+    }
+  }
+
+  void do_parse(const parse_context& ctx, const string_view text) override {
+    parse_into_store(ctx, text, has_try_parse<T>());
+  }
+
+  bool do_try_parse(const parse_context& ctx,
+                    const string_view text) override {
+    return convert(ctx, text, has_try_parse<T>());
+  }
+
+  bool do_cache_default(const parse_context& ctx,
+                        const std::string& text) override {
+    return cache(ctx, text, default_cache_);
+  }
+
+  bool do_cache_implicit(const parse_context& ctx,
+                         const std::string& text) override {
+    return cache(ctx, text, implicit_cache_);
+  }
+
+  void do_assign_default() override {
+    assign_value(*store_, *default_cache_);
+  }
+
+  void do_assign_implicit() override {
+    assign_value(*store_, *implicit_cache_);
+  }
+
+  std::string do_format_default(const parse_context& ctx) const override {
+    return format_(ctx, *default_cache_);
+  }
+
+  std::string do_format_implicit(const parse_context& ctx) const override {
+    return format_(ctx, *implicit_cache_);
+  }
+
+private:
+  struct clone_tag {};
+
+public:
+  /// Copies settings of the value. Uses own storage unless the value
+  /// is bound to a variable. The tag keeps the constructor for clones.
+  basic_value(const basic_value& rhs, clone_tag)
+    : value_base(rhs)
+    , result_()
+    , store_(rhs.do_is_bound() ? rhs.store_ : &result_)
+    , default_cache_(rhs.default_cache_)
+    , implicit_cache_(rhs.implicit_cache_)
+    , format_(rhs.format_) {
   }
 
 private:
   basic_value(const basic_value& rhs) = delete;
   basic_value& operator=(const basic_value& rhs) = delete;
 
+  std::shared_ptr<basic_value> self() {
+    return std::static_pointer_cast<basic_value>(shared_from_this());
+  }
+
+  /// Builtin parsers read the text in place.
+  void parse_into_store(const parse_context& ctx,
+                        const string_view text,
+                        std::true_type) {
+    parse_text(ctx, text, *store_);
+  }
+
+  /// Other parsers take the text as a std::string.
+  void parse_into_store(const parse_context& ctx,
+                        const string_view text,
+                        std::false_type) {
+    parser_type().parse(ctx, detail::to_string(text), *store_);
+  }
+
+  bool convert(const parse_context& ctx,
+               const string_view text,
+               std::true_type) {
+    return convert_or_keep(*store_, [&ctx, text](T& value) {
+      return try_parse_value(ctx, text, value);
+    });
+  }
+
+  /// Parsers which report errors only by exceptions.
+  bool convert(const parse_context& ctx,
+               const string_view text,
+               std::false_type) {
+    return convert_or_keep(*store_, [&ctx, text](T& value) {
+#ifndef CXXOPTS_NO_EXCEPTIONS
+      try {
+        parser_type().parse(ctx, detail::to_string(text), value);
+      } catch (const std::exception&) {
+        return false;
+      }
+#else
+      parser_type().parse(ctx, detail::to_string(text), value);
+#endif
+      return true;
+    });
+  }
+
+  static bool cache(const parse_context& ctx,
+                    const std::string& text,
+                    std::shared_ptr<const T>& target) {
+    if (!is_cacheable<T>::value) {
+      return false;
+    }
+    T value{};
+    parser_type().parse(ctx, text, value);
+    target = std::make_shared<const T>(std::move(value));
+    return true;
+  }
+
 private:
-  std::unique_ptr<T> result_{};
+  /// Storage of a value which is not bound to a variable.
+  T result_{};
   T* store_{};
+  /// Converted default and implicit values shared by all clones.
+  std::shared_ptr<const T> default_cache_{};
+  std::shared_ptr<const T> implicit_cache_{};
+  /// Formats the typed default and implicit values. Set only by the typed
+  /// setters, so types which cannot be formatted can be used otherwise.
+  std::string (*format_)(const parse_context&, const T&){nullptr};
+
+  static std::string format_typed(const parse_context& ctx, const T& value) {
+    return format_value(ctx, value);
+  }
 };
 
 } // namespace detail
@@ -949,30 +2349,108 @@ std::shared_ptr<detail::basic_value<T>> inline value(T& t) {
 /**@}*/
 
 namespace cxxopts {
+namespace detail {
+/**
+ * Returns the number of bytes the string takes from the heap. Short
+ * strings are kept inline.
+ */
+inline std::size_t heap_size(const std::string& s) noexcept {
+  return s.capacity() > std::string().capacity() ? s.capacity() + 1 : 0;
+}
+
+#ifdef CXXOPTS_USE_UNICODE
+inline std::size_t heap_size(const icu::UnicodeString& s) {
+  const auto capacity = static_cast<std::size_t>(s.getCapacity());
+  const auto inline_capacity =
+    static_cast<std::size_t>(icu::UnicodeString().getCapacity());
+  return capacity > inline_capacity ? capacity * sizeof(UChar) : 0;
+}
+#endif
+
+/**
+ * Text of a specification. The text is either owned or refers to
+ * a string with static storage duration, such as a string literal.
+ */
+class spec_text {
+public:
+  spec_text() = default;
+  spec_text(const spec_text&) = default;
+  spec_text(spec_text&&) = default;
+
+  spec_text& operator=(const spec_text&) = default;
+  spec_text& operator=(spec_text&&) = default;
+
+  explicit spec_text(std::string text) noexcept
+    : owned_(std::move(text)) {
+  }
+
+  /** Refers to the text without copying it. */
+  static spec_text borrow(const string_view text) noexcept {
+    spec_text result;
+    result.data_ = text.data();
+    result.size_ = text.size();
+    return result;
+  }
+
+  CXXOPTS_NODISCARD
+  string_view view() const noexcept {
+    return data_ ? string_view(data_, size_)
+                 : string_view(owned_.data(), owned_.size());
+  }
+
+  CXXOPTS_NODISCARD
+  std::size_t heap_size() const noexcept {
+    return detail::heap_size(owned_);
+  }
+
+private:
+  std::string owned_{};
+  const char* data_{nullptr};
+  std::size_t size_{0};
+};
+
+} // namespace detail
 
 class option_details {
 public:
   option_details(std::string short_name,
                  std::string long_name,
-                 std::string arg_help,
-                 cxx_string desc,
-                 std::shared_ptr<detail::value_base> val)
+                 detail::spec_text arg_help,
+                 detail::spec_text desc,
+                 std::shared_ptr<detail::value_base> val,
+                 const std::size_t id)
     : short_(std::move(short_name))
     , long_(std::move(long_name))
     , arg_help_(std::move(arg_help))
     , desc_(std::move(desc))
-    , hash_(std::hash<std::string>{}(long_ + short_))
+    , id_(id)
     , value_(std::move(val)) {
   }
 
   CXXOPTS_NODISCARD
-  const std::string& arg_help() const noexcept {
-    return arg_help_;
+  std::string arg_help() const {
+    return detail::to_string(arg_help_.view());
+  }
+
+  CXXOPTS_NODISCARD
+  string_view arg_help_view() const noexcept {
+    return arg_help_.view();
+  }
+
+  /**
+   * Description of the option converted to the string type of the help.
+   */
+  CXXOPTS_NODISCARD
+  cxx_string description() const {
+    return make_local_string(desc_.view());
   }
 
+  /**
+   * Description of the option as it was given, without a copy.
+   */
   CXXOPTS_NODISCARD
-  const cxx_string& description() const noexcept {
-    return desc_;
+  string_view description_view() const noexcept {
+    return desc_.view();
   }
 
   CXXOPTS_NODISCARD
@@ -995,9 +2473,22 @@ public:
     return long_;
   }
 
+  /**
+   * Position of the option in the order of registration.
+   */
+  CXXOPTS_NODISCARD
+  std::size_t id() const noexcept {
+    return id_;
+  }
+
+  /**
+   * Hash of the names of the option, which older versions used as a key
+   * of parsed values.
+   */
+  CXXOPTS_DEPRECATED("options are identified by id()")
   CXXOPTS_NODISCARD
-  std::size_t hash() const noexcept {
-    return hash_;
+  std::size_t hash() const {
+    return std::hash<std::string>{}(long_ + short_);
   }
 
   CXXOPTS_NODISCARD
@@ -1031,22 +2522,143 @@ public:
   }
 
 private:
+  friend class options;
+
   /// Short name of the option.
   std::string short_;
   /// Long name of the option.
   std::string long_;
-  std::string arg_help_;
+  detail::spec_text arg_help_;
   /// Description of the option.
-  cxx_string desc_;
-  std::size_t hash_;
+  detail::spec_text desc_;
+  /// Dense identifier assigned at registration.
+  std::size_t id_;
   std::shared_ptr<detail::value_base> value_;
 };
 
+/**
+ * Typed reference to an option of a specification. Gives access to the value
+ * of the option in a parse result without looking up the name.
+ *
+ * A handle is valid for results of the specification which returned it.
+ * Results of other specifications reject it.
+ */
+template <typename T>
+class option_handle {
+public:
+  CXXOPTS_NODISCARD
+  std::size_t id() const noexcept {
+    return id_;
+  }
+
+private:
+  friend class options;
+  friend class parse_result;
+
+  /// Only options::add_option() makes handles, so the type of a handle
+  /// always matches the type of the value of its option.
+  explicit option_handle(const option_details& option) noexcept
+    : option_(&option)
+    , id_(option.id()) {
+  }
+
+  /// Details of the option, compared with the ones of a result but never
+  /// accessed through the handle.
+  const option_details* option_;
+  std::size_t id_;
+};
+
+namespace detail {
+
+/**
+ * Texts of the values whose conversion was deferred, packed in a single
+ * buffer, and the lock which serializes their conversion on the first
+ * access. Shared by a parse result and its deferred values.
+ */
+struct deferred_texts {
+  explicit deferred_texts(const result_allocator<char>& alloc)
+    : buffer(alloc) {
+  }
+
+  result_string buffer;
+  std::mutex mutex{};
+};
+
+/**
+ * Flag which can be read without the lock while another thread holds
+ * the lock to clear it. Copies take the current state of the flag.
+ */
+class deferred_flag {
+public:
+  deferred_flag() = default;
+
+  deferred_flag(const deferred_flag& other) noexcept
+    : value_(other.get()) {
+  }
+
+  deferred_flag& operator=(const deferred_flag& other) noexcept {
+    set(other.get());
+    return *this;
+  }
+
+  bool get() const noexcept {
+    return value_.load(std::memory_order_acquire);
+  }
+
+  void set(const bool value) noexcept {
+    value_.store(value, std::memory_order_release);
+  }
+
+private:
+  std::atomic<bool> value_{false};
+};
+
+} // namespace detail
+
 /**
  * Parsed value of an option.
  */
 class option_value {
 public:
+  using allocator_type = detail::result_allocator<char>;
+
+  option_value() = default;
+  option_value(const option_value&) = default;
+  option_value(option_value&&) = default;
+
+  option_value& operator=(const option_value&) = default;
+  option_value& operator=(option_value&&) = default;
+
+  /// Constructors used by containers of a parse result, so that values
+  /// allocate from the same memory as the result.
+  explicit option_value(const allocator_type& alloc)
+    : pending_(alloc) {
+  }
+
+  option_value(const option_value& rhs, const allocator_type& alloc)
+    : long_name_(rhs.long_name_)
+    , value_(rhs.value_)
+    , pending_(rhs.pending_, alloc)
+    , texts_(rhs.texts_)
+    , count_(rhs.count_)
+    , default_(rhs.default_)
+    , owned_(rhs.owned_)
+    , deferred_(rhs.deferred_)
+    , pending_default_(rhs.pending_default_) {
+  }
+
+  option_value(option_value&& rhs, const allocator_type& alloc)
+    : long_name_(rhs.long_name_)
+    , value_(std::move(rhs.value_))
+    , pending_(std::move(rhs.pending_), alloc)
+    , texts_(std::move(rhs.texts_))
+    , count_(rhs.count_)
+    , default_(rhs.default_)
+    , owned_(rhs.owned_)
+    , deferred_(rhs.deferred_)
+    , pending_default_(rhs.pending_default_) {
+  }
+
   /**
    * A number of occurrences of the option value in
    * the command line arguments.
@@ -1068,21 +2680,21 @@ public:
    */
   CXXOPTS_NODISCARD
   bool has_value() const noexcept {
-    return value_ != nullptr;
+    return count_ != 0 || default_;
   }
 
   /**
    * Casts option value to the specific type.
+   *
+   * If conversion of the value was deferred, it is done by the first call.
+   * Conversion is serialized, so a result can be read by several threads.
    */
   template <typename T>
   const T& as() const {
-    if (!has_value()) {
-      detail::throw_or_mimic<option_has_no_value_error>(long_name_);
-    }
 #ifdef CXXOPTS_NO_RTTI
-    return static_cast<const detail::basic_value<T>&>(*value_).get();
+    return static_cast<const detail::basic_value<T>&>(checked_value()).get();
 #else
-    return dynamic_cast<const detail::basic_value<T>&>(*value_).get();
+    return dynamic_cast<const detail::basic_value<T>&>(checked_value()).get();
 #endif
   }
 
@@ -1090,11 +2702,25 @@ public:
   /**
    * Parses option value from the given text.
    */
-  void parse(const option_details& details, const std::string& text) {
+  void parse(const option_details& details, const string_view text) {
     ensure_value(details);
     ++count_;
     value_->parse(text);
-    long_name_ = details.long_name();
+    long_name_ = &details.long_name();
+  }
+
+  /**
+   * Parses option value from the given text. Returns false if the text
+   * is not a valid value.
+   */
+  bool try_parse(const option_details& details, const string_view text) {
+    ensure_value(details);
+    long_name_ = &details.long_name();
+    if (!value_->try_parse(text)) {
+      return false;
+    }
+    ++count_;
+    return true;
   }
 
   /**
@@ -1103,107 +2729,948 @@ public:
   void parse_default(const option_details& details) {
     ensure_value(details);
     default_ = true;
-    long_name_ = details.long_name();
-    value_->parse();
+    long_name_ = &details.long_name();
+    value_->parse_default();
   }
 
-  void parse_no_value(const option_details& details) {
-    long_name_ = details.long_name();
+  /**
+   * Parses option value from the implicit value.
+   */
+  void parse_implicit(const option_details& details) {
+    ensure_value(details);
+    ++count_;
+    value_->parse_implicit();
+    long_name_ = &details.long_name();
   }
 
-private:
-  void ensure_value(const option_details& details) {
-    if (value_ == nullptr) {
-      value_ = details.value();
-    }
+  void parse_no_value(const option_details& details) {
+    long_name_ = &details.long_name();
   }
 
-  std::string long_name_{};
-  // Holding this pointer is safe, since option_value's only exist
-  // in key-value pairs, where the key has the string we point to.
-  std::shared_ptr<detail::value_base> value_{};
-  std::size_t count_{0};
-  bool default_{false};
-};
+  /**
+   * Records position of the text of the value in the buffer.
+   * The text will be parsed on the first access to the value.
+   */
+  void defer(const option_details& details,
+             const std::shared_ptr<detail::deferred_texts>& texts,
+             const std::size_t offset,
+             const std::size_t length) {
+    defer_value(details, texts);
+    ++count_;
+    pending_.emplace_back(offset, length);
+    long_name_ = &details.long_name();
+  }
 
-/**
- * Provides the result of parsing of the command line arguments.
- */
-class parse_result {
-public:
-  /// Maps option name to hash of the name.
-  using name_hash_map = std::unordered_map<std::string, std::size_t>;
-  /// Maps hash of an option name to the option value.
-  using parsed_hash_map = std::unordered_map<std::size_t, option_value>;
+  /**
+   * Records that the value should be parsed from the default value
+   * on the first access to it.
+   */
+  void defer_default(const option_details& details,
+                     const std::shared_ptr<detail::deferred_texts>& texts) {
+    defer_value(details, texts);
+    default_ = true;
+    pending_default_ = true;
+    long_name_ = &details.long_name();
+  }
 
-  class key_value {
-  public:
-    key_value(std::string key, std::string value) noexcept
-      : key_(std::move(key))
-      , value_(std::move(value)) {
+  /**
+   * Drops parsed value but keeps allocated storage for reuse. Storage
+   * shared with copies of the value is left to them, and the next parse
+   * makes new storage.
+   */
+  void reset() {
+    if (owned_ && value_.use_count() == 1) {
+      value_->reset();
+    } else if (owned_) {
+      value_.reset();
+      owned_ = false;
     }
+    pending_.clear();
+    texts_.reset();
+    pending_default_ = false;
+    deferred_.set(false);
+    count_ = 0;
+    default_ = false;
+  }
 
-    CXXOPTS_NODISCARD
-    const std::string& key() const noexcept {
-      return key_;
-    }
+private:
+  friend class parse_result;
 
-    CXXOPTS_NODISCARD
-    const std::string& value() const noexcept {
-      return value_;
-    }
+  /**
+   * Returns storage of the value, converting the value if needed.
+   */
+  const detail::value_base& checked_value() const {
+    if (!has_value()) {
+      detail::throw_or_mimic<option_has_no_value_error>(
+        long_name_ ? *long_name_ : std::string());
+    }
+    // The flag is cleared after conversion, so converted values are read
+    // without the lock.
+    if (deferred_.get()) {
+      std::lock_guard<std::mutex> lock(texts_->mutex);
+      if (deferred_.get()) {
+        convert();
+      }
+    }
+    return *value_;
+  }
+
+  void ensure_value(const option_details& details) {
+    if (!owned_) {
+      value_ = details.value()->clone(get_allocator());
+      owned_ = true;
+    }
+  }
+
+  void defer_value(const option_details& details,
+                   const std::shared_ptr<detail::deferred_texts>& texts) {
+    // Until the conversion, keep the prototype from the specification
+    // instead of the storage. Copies of the value share the prototype,
+    // so each of them converts into the storage of its own.
+    value_ = details.value();
+    owned_ = false;
+    texts_ = texts;
+    deferred_.set(true);
+  }
+
+  void convert() const {
+    if (owned_) {
+      value_->reset();
+    } else {
+      value_ = value_->clone(get_allocator());
+      owned_ = true;
+    }
+    // Texts are dropped only after successful conversion, so a failed
+    // conversion fails again on the next access.
+    for (const auto& slice : pending_) {
+      value_->parse(
+        string_view(texts_->buffer.data() + slice.first, slice.second));
+    }
+    if (pending_default_) {
+      value_->parse_default();
+    }
+    pending_.clear();
+    pending_default_ = false;
+    deferred_.set(false);
+  }
+
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(pending_.get_allocator());
+  }
+
+  /// Long name of the option, owned by the specification.
+  const std::string* long_name_{nullptr};
+  /// Storage of the value owned by the parse result, or the prototype from
+  /// the specification while conversion of the value is deferred.
+  mutable std::shared_ptr<detail::value_base> value_{};
+  /// Positions of the texts of the value which have not been parsed yet.
+  mutable detail::result_vector<std::pair<std::size_t, std::size_t>>
+    pending_{};
+  /// Buffer with the texts of deferred values.
+  std::shared_ptr<detail::deferred_texts> texts_{};
+  std::size_t count_{0};
+  bool default_{false};
+  /// The value points to the storage owned by the result.
+  mutable bool owned_{false};
+  /// Conversion of the value has been deferred.
+  mutable detail::deferred_flag deferred_{};
+  /// The default value should be parsed on conversion.
+  mutable bool pending_default_{false};
+};
+
+namespace detail {
+
+/**
+ * Monotonic buffer for objects of a specification. Memory is taken from
+ * a list of blocks of growing size and is released all at once when
+ * the arena is destroyed.
+ */
+class arena {
+  struct block {
+    block* next;
+  };
+
+public:
+  explicit arena(const std::size_t block_size = 4096) noexcept
+    : next_size_(block_size) {
+  }
+
+  arena(const arena&) = delete;
+  arena& operator=(const arena&) = delete;
+
+  ~arena() {
+    while (head_) {
+      block* const next = head_->next;
+      ::operator delete(head_);
+      head_ = next;
+    }
+  }
+
+  void* allocate(const std::size_t size, const std::size_t alignment) {
+    auto p = align(current_, alignment);
+    if (p == nullptr || size > static_cast<std::size_t>(end_ - p)) {
+      grow(size + alignment);
+      p = align(current_, alignment);
+    }
+    current_ = p + size;
+    reserved_ += size;
+    return p;
+  }
+
+  /**
+   * Copies the text into the arena.
+   */
+  string_view copy(const string_view text) {
+    if (text.empty()) {
+      return string_view();
+    }
+    auto p = static_cast<char*>(allocate(text.size(), 1));
+    std::memcpy(p, text.data(), text.size());
+    return string_view(p, text.size());
+  }
+
+  /**
+   * Number of bytes handed out by the arena.
+   */
+  std::size_t allocated() const noexcept {
+    return reserved_;
+  }
+
+private:
+  static char* align(char* const p, const std::size_t alignment) noexcept {
+    if (p == nullptr) {
+      return nullptr;
+    }
+    const auto address = reinterpret_cast<std::uintptr_t>(p);
+    const auto aligned = (address + alignment - 1) & ~(alignment - 1);
+    return p + (aligned - address);
+  }
+
+  void grow(const std::size_t size) {
+    const auto capacity = std::max(next_size_, size);
+    auto b = static_cast<block*>(::operator new(sizeof(block) + capacity));
+    b->next = head_;
+    head_ = b;
+    current_ = reinterpret_cast<char*>(b + 1);
+    end_ = current_ + capacity;
+    // Grow geometrically to keep the number of blocks logarithmic.
+    next_size_ = std::min<std::size_t>(next_size_ * 2, 1u << 20);
+  }
+
+private:
+  block* head_{nullptr};
+  char* current_{nullptr};
+  char* end_{nullptr};
+  std::size_t next_size_;
+  std::size_t reserved_{0};
+};
+
+/**
+ * Allocator which takes memory from an arena, or from the global heap
+ * if there is no arena. Objects allocated from the arena keep it alive.
+ */
+template <typename T>
+class arena_allocator {
+public:
+  using value_type = T;
+  /// Containers moved or swapped keep memory of their arena.
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  arena_allocator() noexcept = default;
+
+  explicit arena_allocator(std::shared_ptr<arena> a) noexcept
+    : arena_(std::move(a)) {
+  }
+
+  template <typename U>
+  arena_allocator(const arena_allocator<U>& other) noexcept
+    : arena_(other.get_arena()) {
+  }
+
+  /// Copies of containers do not share the arena.
+  arena_allocator select_on_container_copy_construction() const noexcept {
+    return arena_allocator();
+  }
+
+  T* allocate(const std::size_t n) {
+    if (arena_) {
+      return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T* const p, std::size_t) noexcept {
+    // Memory of the arena is released with the arena.
+    if (!arena_) {
+      ::operator delete(p);
+    }
+  }
+
+  const std::shared_ptr<arena>& get_arena() const noexcept {
+    return arena_;
+  }
+
+  template <typename U>
+  bool operator==(const arena_allocator<U>& other) const noexcept {
+    return arena_ == other.get_arena();
+  }
+
+  template <typename U>
+  bool operator!=(const arena_allocator<U>& other) const noexcept {
+    return arena_ != other.get_arena();
+  }
+
+private:
+  std::shared_ptr<arena> arena_{};
+};
+
+inline uint32_t hash_name(const char* name, const std::size_t length) noexcept {
+  // FNV-1a.
+  uint32_t hash = 2166136261u;
+  for (std::size_t i = 0; i != length; ++i) {
+    hash ^= static_cast<unsigned char>(name[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/**
+ * Optional arena of a specification. A copy of the holder gets its own
+ * arena, so copies of a specification do not share mutable state.
+ */
+class arena_holder {
+public:
+  arena_holder() noexcept = default;
+
+  arena_holder(const arena_holder& other)
+    : arena_(other.arena_ ? std::make_shared<arena>() : nullptr) {
+  }
+
+  arena_holder& operator=(const arena_holder& other) {
+    if (this != &other) {
+      reset(other.arena_ != nullptr);
+    }
+    return *this;
+  }
+
+  arena_holder(arena_holder&&) noexcept = default;
+  arena_holder& operator=(arena_holder&&) noexcept = default;
+
+  void reset(const bool enable) {
+    arena_ = enable ? std::make_shared<arena>() : nullptr;
+  }
+
+  const std::shared_ptr<arena>& get() const noexcept {
+    return arena_;
+  }
+
+private:
+  std::shared_ptr<arena> arena_{};
+};
+
+/**
+ * Immutable lookup table over names of the options.
+ *
+ * All names are packed into a single buffer and addressed through
+ * an open-addressing table with linear probing, so a lookup costs
+ * one pass of hashing over the name and a probe or two in a flat array.
+ */
+class option_index {
+  struct slot {
+    /// Hash of the name.
+    uint32_t hash;
+    /// Offset of the name in the buffer of names.
+    uint32_t offset;
+    /// Length of the name.
+    uint32_t length;
+    /// Position of the option in the list of options, or npos for
+    /// an empty slot.
+    uint32_t id;
+  };
+
+  static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+public:
+  using option_list = std::vector<std::shared_ptr<option_details>>;
+
+  explicit option_index(option_list options)
+    : options_(std::move(options)) {
+    std::size_t count = 0;
+    std::size_t length = 0;
+    // Calculate space required for the names.
+    for (const auto& o : options_) {
+      count += !o->short_name().empty() + !o->long_name().empty();
+      length += o->short_name().size() + o->long_name().size();
+    }
+    // Keep load factor of the table at or below 0.5.
+    std::size_t capacity = 8;
+    while (capacity < count * 2) {
+      capacity *= 2;
+    }
+    names_.reserve(length);
+    slots_.assign(capacity, slot{0, 0, 0, npos});
+    mask_ = capacity - 1;
+    for (auto& id : short_) {
+      id = npos;
+    }
+    // Fill the table.
+    for (std::size_t i = 0; i != options_.size(); ++i) {
+      const auto& o = options_[i];
+      // Identifiers of the options are positions in the list.
+      assert(o->id() == i);
+
+      if (!o->short_name().empty()) {
+        const auto ch = static_cast<unsigned char>(o->short_name()[0]);
+
+        insert(o->short_name(), static_cast<uint32_t>(i));
+        if (ch < short_.size()) {
+          short_[ch] = static_cast<uint32_t>(i);
+        }
+      }
+      if (!o->long_name().empty()) {
+        insert(o->long_name(), static_cast<uint32_t>(i));
+      }
+    }
+  }
+
+  /**
+   * Returns the option with the given short or long name, or nullptr
+   * if there is no such option.
+   */
+  CXXOPTS_NODISCARD
+  const option_details* find(const char* name,
+                             const std::size_t length) const noexcept {
+    const uint32_t hash = hash_name(name, length);
+
+    for (std::size_t i = hash & mask_;; i = (i + 1) & mask_) {
+      const slot& s = slots_[i];
+
+      if (s.id == npos) {
+        return nullptr;
+      }
+      if (s.hash == hash && s.length == length &&
+          std::char_traits<char>::compare(names_.data() + s.offset, name,
+                                          length) == 0)
+      {
+        return options_[s.id].get();
+      }
+    }
+  }
+
+  CXXOPTS_NODISCARD
+  const option_details* find(const std::string& name) const noexcept {
+    return find(name.data(), name.size());
+  }
+
+  /**
+   * Returns the option with the given short name, or nullptr
+   * if there is no such option.
+   */
+  CXXOPTS_NODISCARD
+  const option_details* find(const char name) const noexcept {
+    const auto ch = static_cast<unsigned char>(name);
+    // Only ASCII names are mapped directly.
+    if (ch >= short_.size()) {
+      return find(&name, 1);
+    }
+    return short_[ch] == npos ? nullptr : options_[short_[ch]].get();
+  }
+
+  /**
+   * Returns list of the options. Each option is listed once, regardless
+   * of how many names it has.
+   */
+  CXXOPTS_NODISCARD
+  const option_list& options() const noexcept {
+    return options_;
+  }
+
+  /**
+   * Returns the number of bytes taken by the table, except for
+   * the options themselves.
+   */
+  CXXOPTS_NODISCARD
+  std::size_t memory_usage() const noexcept {
+    return sizeof(*this) +
+           options_.capacity() * sizeof(option_list::value_type) +
+           slots_.capacity() * sizeof(slot) + heap_size(names_);
+  }
+
+private:
+  void insert(const std::string& name, const uint32_t id) {
+    const uint32_t hash = hash_name(name.data(), name.size());
+
+    std::size_t i = hash & mask_;
+    while (slots_[i].id != npos) {
+      i = (i + 1) & mask_;
+    }
+
+    slots_[i] = slot{hash, static_cast<uint32_t>(names_.size()),
+                     static_cast<uint32_t>(name.size()), id};
+    names_.append(name);
+  }
+
+private:
+  /// List of the indexed options.
+  const option_list options_;
+  /// Hash table of the names.
+  std::vector<slot> slots_{};
+  /// Names of the options packed in a single buffer.
+  std::string names_{};
+  std::size_t mask_{0};
+  /// Direct mapping from a short name to the option.
+  std::array<uint32_t, 128> short_{};
+};
+
+/**
+ * Set of the names taken by options of a specification, used to reject
+ * duplicate names while options are added.
+ *
+ * The table keeps only identifiers of the options. Names are read from
+ * the options themselves, so they are not stored twice.
+ */
+class name_table {
+  /// Identifier of the option and whether the long name of the option
+  /// is referred, packed as id * 2 + long, or npos for an empty slot.
+  struct slot {
+    uint32_t hash;
+    uint32_t ref;
+  };
+
+  static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+public:
+  using option_list = option_index::option_list;
+
+  /**
+   * Returns true if the name is taken by any of the options.
+   */
+  CXXOPTS_NODISCARD
+  bool contains(const option_list& options,
+                const std::string& name) const noexcept {
+    if (slots_.empty()) {
+      return false;
+    }
+
+    const uint32_t hash = hash_name(name.data(), name.size());
+
+    for (std::size_t i = hash & (slots_.size() - 1);;
+         i = (i + 1) & (slots_.size() - 1))
+    {
+      const slot& s = slots_[i];
+
+      if (s.ref == npos) {
+        return false;
+      }
+      if (s.hash == hash && name_of(options, s.ref) == name) {
+        return true;
+      }
+    }
+  }
+
+  /**
+   * Adds names of the option with the given identifier.
+   */
+  void insert(const option_list& options, const std::size_t id) {
+    const auto& o = *options[id];
+    const auto ref = static_cast<uint32_t>(id * 2);
+
+    // Keep load factor of the table at or below 0.5.
+    reserve(count_ + 2);
+    if (!o.short_name().empty()) {
+      place(hash_name(o.short_name().data(), o.short_name().size()), ref);
+    }
+    if (!o.long_name().empty()) {
+      place(hash_name(o.long_name().data(), o.long_name().size()), ref + 1);
+    }
+  }
+
+  CXXOPTS_NODISCARD
+  std::size_t memory_usage() const noexcept {
+    return slots_.capacity() * sizeof(slot);
+  }
+
+private:
+  static const std::string& name_of(const option_list& options,
+                                    const uint32_t ref) noexcept {
+    const auto& o = *options[ref / 2];
+    return (ref & 1) ? o.long_name() : o.short_name();
+  }
+
+  void reserve(const std::size_t count) {
+    if (count * 2 <= slots_.size()) {
+      return;
+    }
+
+    std::size_t capacity = slots_.empty() ? 16 : slots_.size() * 2;
+    while (capacity < count * 2) {
+      capacity *= 2;
+    }
+
+    std::vector<slot> old(capacity, slot{0, npos});
+    old.swap(slots_);
+    count_ = 0;
+    for (const auto& s : old) {
+      if (s.ref != npos) {
+        place(s.hash, s.ref);
+      }
+    }
+  }
+
+  void place(const uint32_t hash, const uint32_t ref) noexcept {
+    std::size_t i = hash & (slots_.size() - 1);
+    while (slots_[i].ref != npos) {
+      i = (i + 1) & (slots_.size() - 1);
+    }
+    slots_[i] = slot{hash, ref};
+    ++count_;
+  }
+
+private:
+  std::vector<slot> slots_{};
+  std::size_t count_{0};
+};
+
+/**
+ * Lookup table of a specification, built on the first use and shared by
+ * all later parse calls. The table is immutable, so copies of the holder
+ * share it. Access is serialized, as several threads may parse with
+ * the same specification.
+ */
+class index_cache {
+public:
+  using index_ptr = std::shared_ptr<const option_index>;
+
+  index_cache() = default;
+
+  index_cache(const index_cache& other)
+    : mutex_()
+    , index_(other.get()) {
+  }
+
+  index_cache& operator=(const index_cache& other) {
+    if (this != &other) {
+      auto index = other.get();
+      std::lock_guard<std::mutex> lock(mutex_);
+      index_ = std::move(index);
+    }
+    return *this;
+  }
+
+  index_ptr get() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_;
+  }
+
+  /**
+   * Returns the table, building it over the options if there is none.
+   */
+  index_ptr get(const option_index::option_list& options) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!index_) {
+      index_ = std::make_shared<const option_index>(options);
+    }
+    return index_;
+  }
+
+  void reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    index_.reset();
+  }
+
+private:
+  mutable std::mutex mutex_{};
+  mutable index_ptr index_{};
+};
+
+class option_parser;
+
+} // namespace detail
+
+/**
+ * Provides the result of parsing of the command line arguments.
+ */
+class parse_result {
+public:
+  using allocator_type = detail::result_allocator<char>;
+
+  /// Values of the options indexed by identifiers of the options.
+  using value_list = detail::result_vector<option_value>;
+
+  /// Maps option name to hash of the name.
+  using name_hash_map CXXOPTS_DEPRECATED("values are indexed by option id") =
+    std::unordered_map<std::string, std::size_t>;
+  /// Maps hash of an option name to the option value.
+  using parsed_hash_map CXXOPTS_DEPRECATED("values are indexed by option id") =
+    std::unordered_map<std::size_t, option_value>;
+
+  /**
+   * Name of a recognized option and its value. Refers to the data
+   * of the parse result.
+   */
+  class key_value {
+  public:
+    key_value(const std::string& key, const string_view value) noexcept
+      : key_(&key)
+      , value_(value) {
+    }
+
+    CXXOPTS_NODISCARD
+    const std::string& key() const noexcept {
+      return *key_;
+    }
+
+    CXXOPTS_NODISCARD
+    std::string value() const {
+      return detail::to_string(value_);
+    }
+
+    /**
+     * The value without a copy. Refers to the parse result.
+     */
+    CXXOPTS_NODISCARD
+    string_view value_view() const noexcept {
+      return value_;
+    }
+
+    /**
+     * Parses the value to a variable of the specific type.
+     */
+    template <typename T>
+    T as() const {
+      T result;
+      value_parser<T>().parse(parse_context(), detail::to_string(value_),
+                              result);
+      return result;
+    }
+
+  private:
+    const std::string* key_;
+    string_view value_;
+  };
+
+  /**
+   * Command line argument that did not match any option. Refers to
+   * the command line arguments, which should outlive it.
+   */
+  class unmatched_argument {
+  public:
+    // Positions come from argc, so they always fit into 32 bits.
+    static_assert(std::numeric_limits<int>::max() <=
+                    std::numeric_limits<uint32_t>::max(),
+                  "position of an argument does not fit into 32 bits");
+
+    unmatched_argument(const char* text,
+                       const int index,
+                       const bool fragment) noexcept
+      : text_(text)
+      , index_(static_cast<uint32_t>(index))
+      , fragment_(fragment) {
+      assert(index >= 0);
+    }
 
     /**
-     * Parses the value to a variable of the specific type.
+     * Position of the argument in argv.
      */
-    template <typename T>
-    T as() const {
-      T result;
-      value_parser<T>().parse(parse_context(), value_, result);
-      return result;
+    CXXOPTS_NODISCARD
+    std::size_t index() const noexcept {
+      return index_;
+    }
+
+    /**
+     * Returns true for a letter split from a group of short options,
+     * such as 'x' from "-axb".
+     */
+    CXXOPTS_NODISCARD
+    bool is_fragment() const noexcept {
+      return fragment_;
+    }
+
+    /**
+     * Text of the argument, or the letter of a fragment.
+     */
+    CXXOPTS_NODISCARD
+    string_view text() const noexcept {
+      return fragment_ ? string_view(text_, 1) : string_view(text_);
+    }
+
+    /**
+     * Copy of the argument. A fragment is returned as a short option.
+     */
+    CXXOPTS_NODISCARD
+    std::string str() const {
+      return fragment_ ? std::string{'-', *text_} : std::string(text_);
+    }
+
+  private:
+    const char* text_;
+    uint32_t index_;
+    bool fragment_;
+  };
+
+private:
+  /// Occurrence of an option in the command line arguments.
+  struct argument {
+    const option_details* option;
+    /// Location of the value in the buffer of values.
+    uint32_t offset;
+    uint32_t length;
+  };
+
+public:
+  /**
+   * Sequence of recognized options in order of appearance.
+   */
+  class argument_list {
+  public:
+    class const_iterator {
+    public:
+      using value_type = key_value;
+      using difference_type = std::ptrdiff_t;
+      using iterator_category = std::input_iterator_tag;
+      using pointer = void;
+      using reference = key_value;
+
+      const_iterator(const argument_list* list, std::size_t pos) noexcept
+        : list_(list)
+        , pos_(pos) {
+      }
+
+      key_value operator*() const noexcept {
+        return (*list_)[pos_];
+      }
+
+      const_iterator& operator++() noexcept {
+        ++pos_;
+        return *this;
+      }
+
+      bool operator==(const const_iterator& rhs) const noexcept {
+        return pos_ == rhs.pos_;
+      }
+
+      bool operator!=(const const_iterator& rhs) const noexcept {
+        return pos_ != rhs.pos_;
+      }
+
+    private:
+      const argument_list* list_;
+      std::size_t pos_;
+    };
+
+    argument_list(const detail::result_vector<argument>& args,
+                  const detail::result_string& values) noexcept
+      : args_(args)
+      , values_(values) {
+    }
+
+    CXXOPTS_NODISCARD
+    std::size_t size() const noexcept {
+      return args_.size();
+    }
+
+    CXXOPTS_NODISCARD
+    bool empty() const noexcept {
+      return args_.empty();
+    }
+
+    key_value operator[](const std::size_t i) const noexcept {
+      const auto& arg = args_[i];
+      return key_value(arg.option->canonical_name(),
+                       string_view(values_.data() + arg.offset, arg.length));
+    }
+
+    const_iterator begin() const noexcept {
+      return const_iterator(this, 0);
+    }
+
+    const_iterator end() const noexcept {
+      return const_iterator(this, args_.size());
+    }
+
+    /// Copies the list, as older versions returned a vector.
+    operator std::vector<key_value>() const {
+      return std::vector<key_value>(begin(), end());
     }
 
   private:
-    const std::string key_;
-    const std::string value_;
+    const detail::result_vector<argument>& args_;
+    const detail::result_string& values_;
   };
 
 public:
   parse_result() = default;
   parse_result(const parse_result&) = default;
   parse_result(parse_result&&) = default;
-  parse_result(name_hash_map&& keys,
-               parsed_hash_map&& values,
+
+  /**
+   * Creates an empty result which allocates values of the options and
+   * the list of recognized options from the allocator.
+   */
+  explicit parse_result(const allocator_type& alloc)
+    : values_(alloc)
+    , sequential_(alloc)
+    , sequential_values_(alloc)
+    , unmatched_arguments_(alloc) {
+  }
+
+  /**
+   * Builds a result from values keyed by hashes of the option names, as
+   * older versions stored them. Options are recreated from the names, so
+   * the result can be read by name but not through option handles.
+   */
+  CXXOPTS_DEPRECATED("results should be built by options::parse()")
+  parse_result(std::unordered_map<std::string, std::size_t>&& keys,
+               std::unordered_map<std::size_t, option_value>&& values,
                std::vector<key_value>&& sequential,
                std::vector<std::string>&& unmatched_args,
                std::size_t consumed)
-    : keys_(std::move(keys))
-    , values_(std::move(values))
-    , sequential_(std::move(sequential))
-    , unmatched_(std::move(unmatched_args))
+    : unmatched_(std::move(unmatched_args))
     , consumed_arguments_(consumed) {
+    // Names of an option share the hash of the option.
+    std::map<std::size_t, std::pair<std::string, std::string>> names;
+    for (const auto& key : keys) {
+      if (values.count(key.second) != 0) {
+        auto& name = names[key.second];
+        (key.first.size() == 1 ? name.first : name.second) = key.first;
+      }
+    }
+    detail::option_index::option_list options;
+    for (auto& name : names) {
+      auto& value = values[name.first];
+      options.push_back(std::make_shared<option_details>(
+        std::move(name.second.first), std::move(name.second.second),
+        detail::spec_text(), detail::spec_text(), value.value_,
+        options.size()));
+      value.long_name_ = &options.back()->long_name();
+      values_.push_back(std::move(value));
+    }
+    index_ = std::make_shared<detail::option_index>(std::move(options));
+    for (const auto& kv : sequential) {
+      if (const auto* option = find(kv.key())) {
+        add_argument(sequential_, sequential_values_, *option,
+                     kv.value_view());
+      }
+    }
   }
 
   parse_result& operator=(const parse_result&) = default;
   parse_result& operator=(parse_result&&) = default;
 
+  CXXOPTS_NODISCARD
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(values_.get_allocator());
+  }
+
   /**
    * Returns a number of occurrences of the option in
    * the command line arguments.
    */
   CXXOPTS_NODISCARD
   std::size_t count(const std::string& name) const {
-    const auto ki = keys_.find(name);
-    if (ki == keys_.end()) {
-      return 0;
-    }
-
-    const auto vi = values_.find(ki->second);
-    if (vi == values_.end()) {
-      return 0;
-    }
-
-    return vi->second.count();
+    const auto opt = find(name);
+    return opt ? values_[opt->id()].count() : 0;
   }
 
   CXXOPTS_NODISCARD
@@ -1211,86 +3678,550 @@ public:
     return count(name) != 0;
   }
 
+  template <typename T>
+  CXXOPTS_NODISCARD std::size_t count(const option_handle<T> handle) const {
+    return checked_value(handle).count();
+  }
+
+  template <typename T>
+  CXXOPTS_NODISCARD bool has(const option_handle<T> handle) const {
+    return count(handle) != 0;
+  }
+
+  /**
+   * Returns value of the option referred by the handle.
+   *
+   * The type of the value is known from the handle, so there is no name
+   * lookup and no run-time type check. A handle of another specification
+   * is reported as option_not_present_error.
+   */
+  template <typename T>
+  const T& get(const option_handle<T> handle) const {
+    return static_cast<const detail::basic_value<T>&>(
+             checked_value(handle).checked_value())
+      .get();
+  }
+
   const option_value& operator[](const std::string& name) const {
-    const auto ki = keys_.find(name);
-    if (ki == keys_.end()) {
+    const auto opt = find(name);
+    if (opt == nullptr) {
       detail::throw_or_mimic<option_not_present_error>(name);
     }
+    return values_[opt->id()];
+  }
 
-    const auto vi = values_.find(ki->second);
-    if (vi == values_.end()) {
-      detail::throw_or_mimic<option_not_present_error>(name);
+  /**
+   * Returns list of recognized options with non empty value.
+   */
+  CXXOPTS_NODISCARD
+  argument_list arguments() const noexcept {
+    return argument_list(sequential_, deferred_ ? deferred_->buffer
+                                                : sequential_values_);
+  }
+
+  /**
+   * Returns number of consumed command line arguments.
+   */
+  CXXOPTS_NODISCARD
+  std::size_t consumed() const noexcept {
+    return consumed_arguments_;
+  }
+
+  /**
+   * Returns list of unmatched arguments. The list is empty if
+   * the specification does not copy unmatched arguments.
+   */
+  CXXOPTS_NODISCARD
+  const std::vector<std::string>& unmatched() const noexcept {
+    return unmatched_;
+  }
+
+  /**
+   * Returns list of unmatched arguments as references to the command
+   * line arguments, without copying them. The list is empty unless
+   * the specification was set up by options::view_unmatched().
+   */
+  CXXOPTS_NODISCARD
+  const detail::result_vector<unmatched_argument>& unmatched_arguments()
+    const noexcept {
+    return unmatched_arguments_;
+  }
+
+private:
+  friend class detail::option_parser;
+
+  const option_details* find(const std::string& name) const noexcept {
+    return index_ ? index_->find(name) : nullptr;
+  }
+
+  /// Returns value of the option the handle was made for. The handle
+  /// should refer to the same option as the result does, which also
+  /// guarantees the type of the value.
+  template <typename T>
+  const option_value& checked_value(const option_handle<T> handle) const {
+    if (!index_ || handle.id() >= values_.size() ||
+        index_->options()[handle.id()].get() != handle.option_)
+    {
+      detail::throw_or_mimic<option_not_present_error>(
+        "#" + std::to_string(handle.id()));
+    }
+    return values_[handle.id()];
+  }
+
+  /// Appends an occurrence of the option to the list of arguments.
+  static void add_argument(detail::result_vector<argument>& args,
+                           detail::result_string& buffer,
+                           const option_details& details,
+                           const string_view text) {
+    // Positions in the buffer are kept in 32 bits.
+    if (text.size() > std::numeric_limits<uint32_t>::max() - buffer.size()) {
+      detail::throw_or_mimic<parse_error>(
+        "Values of the options exceed 4 GiB");
+    }
+    args.push_back(argument{&details, static_cast<uint32_t>(buffer.size()),
+                            static_cast<uint32_t>(text.size())});
+    buffer.append(text.data(), text.size());
+  }
+
+private:
+  /// Index of the options the result was built for.
+  std::shared_ptr<const detail::option_index> index_{};
+  value_list values_{};
+  /// Recognized options in order of appearance.
+  detail::result_vector<argument> sequential_{};
+  /// Values of the recognized options packed in a single buffer.
+  detail::result_string sequential_values_{};
+  /// Buffer used instead of the one above if conversion of values is
+  /// deferred. Values refer to it, so it may outlive the result.
+  std::shared_ptr<detail::deferred_texts> deferred_{};
+  /// List of arguments that did not match to any defined option.
+  std::vector<std::string> unmatched_{};
+  /// References to the arguments that did not match to any defined option.
+  detail::result_vector<unmatched_argument> unmatched_arguments_{};
+  /// Number of consument command line arguments.
+  std::size_t consumed_arguments_{0};
+};
+
+/**
+ * Kind of an error found by options::try_parse().
+ */
+enum class parse_error_code {
+  /// An argument starts with '-' but is not a valid option (option_syntax_error).
+  option_syntax,
+  /// There is no option with the given name (option_not_exists_error).
+  option_not_exists,
+  /// The option requires an argument (missing_argument_error).
+  missing_argument,
+  /// The argument is not a valid value of the option (argument_incorrect_type).
+  incorrect_argument,
+};
+
+/**
+ * Error found by options::try_parse().
+ */
+class parse_failure {
+public:
+  parse_failure(const parse_error_code code,
+                const int index,
+                std::string argument,
+                std::string option)
+    : code_(code)
+    , index_(index)
+    , argument_(std::move(argument))
+    , option_(std::move(option)) {
+  }
+
+  CXXOPTS_NODISCARD
+  parse_error_code code() const noexcept {
+    return code_;
+  }
+
+  /**
+   * Index of the offending argument in argv, or -1 if the value does not
+   * come from the command line, as for values of environment variables.
+   */
+  CXXOPTS_NODISCARD
+  int index() const noexcept {
+    return index_;
+  }
+
+  /**
+   * The offending option name or value.
+   */
+  CXXOPTS_NODISCARD
+  const std::string& argument() const noexcept {
+    return argument_;
+  }
+
+  /**
+   * Name of the option whose value is incorrect. Empty for other errors.
+   */
+  CXXOPTS_NODISCARD
+  const std::string& option() const noexcept {
+    return option_;
+  }
+
+  /**
+   * Formats the description of the error in the form used by
+   * the exceptions of options::parse().
+   */
+  CXXOPTS_NODISCARD
+  std::string message() const {
+    switch (code_) {
+      case parse_error_code::option_syntax:
+        return option_syntax_error(argument_).what();
+      case parse_error_code::option_not_exists:
+        return option_not_exists_error(argument_).what();
+      case parse_error_code::missing_argument:
+        return missing_argument_error(argument_).what();
+      case parse_error_code::incorrect_argument:
+        return argument_incorrect_type(argument_).what();
     }
+    return std::string();
+  }
+
+private:
+  parse_error_code code_;
+  int index_;
+  std::string argument_;
+  std::string option_;
+};
+
+/**
+ * Outcome of options::try_parse(): either a parse result or a list
+ * of errors.
+ */
+class parse_outcome {
+public:
+  CXXOPTS_NODISCARD
+  bool ok() const noexcept {
+    return errors_.empty();
+  }
 
-    return vi->second;
+  explicit operator bool() const noexcept {
+    return ok();
   }
 
   /**
-   * Returns list of recognized options with non empty value.
+   * Parsed values. Complete only if there are no errors.
    */
   CXXOPTS_NODISCARD
-  const std::vector<key_value>& arguments() const noexcept {
-    return sequential_;
+  const parse_result& result() const noexcept {
+    return result_;
+  }
+
+  CXXOPTS_NODISCARD
+  const std::vector<parse_failure>& errors() const noexcept {
+    return errors_;
+  }
+
+private:
+  friend class options;
+
+  parse_result result_{};
+  std::vector<parse_failure> errors_{};
+};
+
+namespace detail {
+
+/**
+ * Splits an option specifier of the form "s,long" into the short and
+ * the long names. Returns false if the specifier is invalid.
+ */
+inline bool parse_option_specifier(const std::string& text,
+                                   std::string& s,
+                                   std::string& l) {
+  const char* p = text.c_str();
+  if (*p == 0) {
+    return false;
+  } else {
+    s.clear();
+    l.clear();
+  }
+  // Short option.
+  if (*(p + 1) == 0 || *(p + 1) == ',') {
+    if (*p == '?' || std::isalnum(*p)) {
+      s = *p;
+      ++p;
+    } else {
+      return false;
+    }
+  }
+  // Skip comma.
+  if (*p == ',') {
+    if (s.empty()) {
+      return false;
+    }
+    ++p;
+  }
+  // Skip spaces.
+  while (*p && *p == ' ') {
+    ++p;
+  }
+  // Valid specifier without long option.
+  if (*p == 0) {
+    return true;
+  } else {
+    l.reserve((text.c_str() + text.size()) - p);
+  }
+  // First char of an option name should be alnum.
+  if (std::isalnum(*p)) {
+    l += *p;
+    ++p;
+  }
+  for (; *p; ++p) {
+    if (*p == '-' || *p == '_' || *p == '.' || std::isalnum(*p)) {
+      l += *p;
+    } else {
+      return false;
+    }
+  }
+  return l.size() > 1;
+}
+
+/// Name and value of an option. Both refer to the argument text.
+struct option_data {
+  string_view name{};
+  string_view value{};
+  bool is_long{false};
+  bool has_value{false};
+};
+
+inline bool is_dash_dash(const char* str) noexcept {
+  return (str[0] != 0 && str[0] == '-') && (str[1] != 0 && str[1] == '-') &&
+         (str[2] == 0);
+}
+
+/**
+ * Splits an argument into the name of an option and its value. Returns
+ * false if the argument does not have the form of an option.
+ */
+inline bool parse_argument(const char* p, option_data& data) noexcept {
+  // The string should be at least two character long and starts with '-'.
+  if (*p == 0 || *(p + 1) == 0 || *p != '-') {
+    return false;
+  }
+  // Skip the '-'.
+  ++p;
+  // Long option starts with '--'.
+  if (*p == '-') {
+    ++p;
+    if (!(std::isalnum(*p) && *(p + 1) != 0)) {
+      return false;
+    }
+    const char* const name = p;
+    for (++p; *p; ++p) {
+      if (*p == '=') {
+        data.has_value = true;
+        data.value = string_view(p + 1);
+        break;
+      }
+      if (!(*p == '-' || *p == '_' || *p == '.' || std::isalnum(*p))) {
+        return false;
+      }
+    }
+    data.is_long = true;
+    data.name = string_view(name, static_cast<std::size_t>(p - name));
+    return data.name.size() > 1;
+  } else {
+    // Single char short option should start with an alnum or
+    // be a question mark.
+    if (!(std::isalnum(*p) || (*p == '?' && *(p + 1) == 0))) {
+      return false;
+    }
+    // Take the whole string and interpret it later as
+    // a group of short options.
+    data.name = string_view(p);
+    return true;
+  }
+}
+
+/**
+ * Converts text to a value without a per-option value object. Errors
+ * are reported as argument_incorrect_type.
+ */
+template <typename T>
+void convert_value(const parse_context& ctx,
+                   const string_view text,
+                   T& value,
+                   std::true_type /* has_try_parse */) {
+  if (!try_parse_value(ctx, text, value)) {
+    throw_or_mimic<argument_incorrect_type>(to_string(text));
   }
+}
+
+template <typename T>
+void convert_value(const parse_context& ctx,
+                   const string_view text,
+                   T& value,
+                   std::false_type /* has_try_parse */) {
+  value_parser<T>().parse(ctx, to_string(text), value);
+}
+
+template <typename T>
+void convert_value(const parse_context& ctx,
+                   const string_view text,
+                   T& value) {
+  convert_value(ctx, text, value, has_try_parse<T>());
+}
+
+/**
+ * Parses a command line for a plain set of options: options of type bool
+ * are flags, other options take a value. There are no positional options,
+ * defaults or environment values; arguments which are not consumed
+ * by options are appended to unmatched.
+ *
+ * The handler resolves names with find(name, index), tells whether an
+ * option is a flag with is_flag(index) and stores values with
+ * assign(index, text).
+ */
+template <typename Handler>
+void parse_plain(const int argc,
+                 const char* const* argv,
+                 Handler& handler,
+                 std::vector<string_view>& unmatched) {
+  // Takes the next argument as the value of an option.
+  const auto next_value = [&](int& current, const string_view name) {
+    if (current + 1 != argc) {
+      const char* const arg = argv[current + 1];
+      option_data data;
+      std::size_t index = 0;
+
+      // Do not consume an option as a value of another option.
+      const bool is_option = arg[0] == '-' &&
+        (is_dash_dash(arg) ||
+         (parse_argument(arg, data) &&
+          (data.is_long ? handler.find(data.name, index)
+                        : handler.find(data.name[0], index))));
+
+      if (!is_option) {
+        return string_view(argv[++current]);
+      }
+    }
+    throw_or_mimic<missing_argument_error>(to_string(name));
+  };
 
-  /**
-   * Returns number of consumed command line arguments.
-   */
-  CXXOPTS_NODISCARD
-  std::size_t consumed() const noexcept {
-    return consumed_arguments_;
-  }
+  for (int current = 1; current < argc; ++current) {
+    const char* const arg = argv[current];
 
-  /**
-   * Returns list of unmatched arguments.
-   */
-  CXXOPTS_NODISCARD
-  const std::vector<std::string>& unmatched() const noexcept {
-    return unmatched_;
-  }
+    if (is_dash_dash(arg)) {
+      for (++current; current < argc; ++current) {
+        unmatched.emplace_back(argv[current]);
+      }
+      break;
+    }
 
-private:
-  name_hash_map keys_{};
-  parsed_hash_map values_{};
-  std::vector<key_value> sequential_{};
-  /// List of arguments that did not match to any defined option.
-  std::vector<std::string> unmatched_{};
-  /// Number of consument command line arguments.
-  std::size_t consumed_arguments_{0};
-};
+    option_data data;
+    std::size_t index = 0;
 
-namespace detail {
+    if (!parse_argument(arg, data)) {
+      if (arg[0] == '-' && arg[1] != '\0') {
+        throw_or_mimic<option_syntax_error>(arg);
+      }
+      unmatched.emplace_back(arg);
+    } else if (data.is_long) {
+      if (!handler.find(data.name, index)) {
+        throw_or_mimic<option_not_exists_error>(to_string(data.name));
+      }
+      if (data.has_value) {
+        handler.assign(index, data.value);
+      } else if (handler.is_flag(index)) {
+        handler.assign(index, "true");
+      } else {
+        handler.assign(index, next_value(current, data.name));
+      }
+    } else {
+      // Single short option or a group of short options.
+      const string_view seq = data.name;
+      for (std::size_t i = 0; i != seq.size(); ++i) {
+        if (!handler.find(seq[i], index)) {
+          throw_or_mimic<option_not_exists_error>(to_string(seq.substr(i, 1)));
+        }
+        if (handler.is_flag(index)) {
+          handler.assign(index, "true");
+        } else if (i + 1 == seq.size()) {
+          handler.assign(index, next_value(current, seq.substr(i, 1)));
+        } else {
+          handler.assign(index, seq.substr(i + 1));
+          break;
+        }
+      }
+    }
+  }
+}
 
 class option_parser {
-  using option_map =
-    std::unordered_map<std::string, std::shared_ptr<option_details>>;
   using positional_list = std::vector<std::string>;
   using positional_list_iterator = positional_list::const_iterator;
 
-  struct option_data {
-    std::string name{};
-    std::string value{};
-    bool is_long{false};
-    bool has_value{false};
-  };
-
 public:
-  option_parser(const option_map& options,
+  option_parser(std::shared_ptr<const option_index> index,
                 const positional_list& positional,
                 bool allow_unrecognised,
-                bool stop_on_positional)
-    : options_(options)
+                bool stop_on_positional,
+                bool lazy_conversion,
+                bool copy_unmatched,
+                parse_result& result)
+    : index_(*index)
     , positional_(positional)
     , allow_unrecognised_(allow_unrecognised)
-    , stop_on_positional_(stop_on_positional) {
+    , stop_on_positional_(stop_on_positional)
+    , lazy_conversion_(lazy_conversion)
+    , copy_unmatched_(copy_unmatched)
+    , parsed_(result.values_)
+    , sequential_(result.sequential_)
+    , unmatched_(result.unmatched_)
+    , unmatched_arguments_(result.unmatched_arguments_)
+    , result_(result) {
+    // Storage of values can be reused only if the result was built for
+    // the same set of options.
+    if (result.index_ == index) {
+      for (auto& value : parsed_) {
+        value.reset();
+      }
+    } else {
+      parsed_.clear();
+      parsed_.resize(index->options().size());
+      result.index_ = std::move(index);
+    }
+    if (!lazy_conversion_) {
+      result.deferred_.reset();
+      values_ = &result.sequential_values_;
+    } else {
+      // The buffer is reused unless it is still referred by values
+      // copied from the result.
+      if (!result.deferred_ || result.deferred_.use_count() != 1) {
+        result.deferred_ = std::allocate_shared<detail::deferred_texts>(
+          detail::result_allocator<detail::deferred_texts>(
+            result.get_allocator()),
+          result.get_allocator());
+      }
+      values_ = &result.deferred_->buffer;
+    }
+    sequential_.clear();
+    values_->clear();
+    unmatched_.clear();
+    unmatched_arguments_.clear();
+  }
+
+  /**
+   * Records errors to the list instead of throwing them. Parsing stops
+   * at the first error unless all errors should be collected.
+   */
+  option_parser& collect_errors(std::vector<parse_failure>& failures,
+                                const bool all) noexcept {
+    failures_ = &failures;
+    collect_all_ = all;
+    return *this;
   }
 
-  parse_result parse(const int argc, const char* const* argv) {
+  void parse(const int argc, const char* const* argv) {
     int current = 1;
     auto next_positional = positional_.begin();
-    std::vector<std::string> unmatched;
 
-    while (current < argc) {
+    while (current < argc && !stopped_) {
+      argument_index_ = current;
+
       if (is_dash_dash(argv[current])) {
         // Skip dash-dash argument.
         ++current;
@@ -1298,14 +4229,18 @@ public:
           break;
         }
         // Try to consume all remaining arguments as positional.
-        for (; current < argc; ++current) {
+        for (; current < argc && !stopped_; ++current) {
+          argument_index_ = current;
           if (!consume_positional(argv[current], next_positional)) {
             break;
           }
         }
+        if (stopped_) {
+          break;
+        }
         // Adjust argv for any that couldn't be swallowed.
         for (; current != argc; ++current) {
-          unmatched.emplace_back(argv[current]);
+          add_unmatched(argv[current], current, false);
         }
         break;
       }
@@ -1317,7 +4252,9 @@ public:
         // But if it starts with a `-`, then it's an error.
         if (argv[current][0] == '-' && argv[current][1] != '\0') {
           if (!allow_unrecognised_) {
-            detail::throw_or_mimic<option_syntax_error>(argv[current]);
+            fail(parse_error_code::option_syntax, argv[current]);
+            ++current;
+            continue;
           }
         }
         if (stop_on_positional_) {
@@ -1326,61 +4263,61 @@ public:
         // If true is returned here then it was consumed, otherwise it
         // is ignored.
         if (!consume_positional(argv[current], next_positional)) {
-          unmatched.emplace_back(argv[current]);
+          add_unmatched(argv[current], current, false);
         }
         // If we return from here then it was parsed successfully, so
         // continue.
       } else if (result.is_long) {
         // Long option.
-        const std::string& name = result.name;
-        const auto oi = options_.find(name);
+        const string_view name = result.name;
+        const auto opt = index_.find(name.data(), name.size());
 
-        if (oi == options_.end()) {
+        if (opt == nullptr) {
           if (allow_unrecognised_) {
             // Keep unrecognised options in argument list,
             // skip to next argument.
-            unmatched.emplace_back(argv[current]);
+            add_unmatched(argv[current], current, false);
             ++current;
             continue;
           }
           // Error.
-          detail::throw_or_mimic<option_not_exists_error>(name);
+          fail(parse_error_code::option_not_exists, name);
+          ++current;
+          continue;
         }
 
-        const auto& opt = oi->second;
         // Equal sign provided for the long option?
         if (result.has_value) {
           // Parse the option given.
-          parse_option(opt, result.value);
+          parse_option(*opt, result.value);
         } else {
           // Parse the next argument.
-          checked_parse_arg(argc, argv, current, opt, name);
+          checked_parse_arg(argc, argv, current, *opt, name);
         }
       } else {
         // Single short option or a group of short options.
-        const std::string& seq = result.name;
+        const string_view seq = result.name;
         // Iterate over the sequence of short options.
-        for (std::size_t i = 0; i != seq.size(); ++i) {
-          const std::string name(1, seq[i]);
-          const auto oi = options_.find(name);
+        for (std::size_t i = 0; i != seq.size() && !stopped_; ++i) {
+          const auto opt = index_.find(seq[i]);
 
-          if (oi == options_.end()) {
+          if (opt == nullptr) {
             if (allow_unrecognised_) {
-              unmatched.push_back(std::string("-") + seq[i]);
+              add_unmatched(seq.data() + i, current, true);
               continue;
             }
             // Error.
-            detail::throw_or_mimic<option_not_exists_error>(name);
+            fail(parse_error_code::option_not_exists, seq.substr(i, 1));
+            continue;
           }
 
-          const auto& opt = oi->second;
           if (i + 1 == seq.size()) {
             // It must be the last argument.
-            checked_parse_arg(argc, argv, current, opt, name);
+            checked_parse_arg(argc, argv, current, *opt, seq.substr(i, 1));
           } else if (opt->has_implicit()) {
-            parse_option(opt, opt->implicit_value());
+            parse_implicit(*opt);
           } else {
-            parse_option(opt, seq.substr(i + 1));
+            parse_option(*opt, seq.substr(i + 1));
             break;
           }
         }
@@ -1390,9 +4327,8 @@ public:
     }
 
     // Setup default or env values.
-    for (auto& opt : options_) {
-      auto& detail = opt.second;
-      auto& store = parsed_[detail->hash()];
+    for (const auto& detail : index_.options()) {
+      auto& store = parsed_[detail->id()];
       const auto& value = detail->value();
 
       // Skip options with parsed values.
@@ -1402,52 +4338,55 @@ public:
       // Try to setup env value.
       if (value->has_env()) {
         if (const char* env = std::getenv(value->get_env_var().c_str())) {
-          store.parse(*detail, std::string(env));
+          if (is_lazy(*detail)) {
+            // The text is kept in the buffer but is not listed
+            // as an argument.
+            const auto offset = values_->size();
+            values_->append(env);
+            store.defer(*detail, result_.deferred_, offset,
+                        values_->size() - offset);
+          } else if (failures_ == nullptr) {
+            store.parse(*detail, env);
+          } else if (!store.try_parse(*detail, env)) {
+            // The value does not come from the command line.
+            argument_index_ = -1;
+            fail(parse_error_code::incorrect_argument, env, detail.get());
+          }
           continue;
         }
       }
       // Try to setup default value.
       if (value->has_default()) {
-        store.parse_default(*detail);
+        if (is_lazy(*detail)) {
+          store.defer_default(*detail, result_.deferred_);
+        } else {
+          store.parse_default(*detail);
+        }
       } else {
         store.parse_no_value(*detail);
       }
     }
 
-    parse_result::name_hash_map keys;
-    // Finalize aliases.
-    for (const auto& option : options_) {
-      const auto& detail = option.second;
-      const auto hash = detail->hash();
-
-      if (detail->short_name().size()) {
-        keys[detail->short_name()] = hash;
-      }
-      if (detail->long_name().size()) {
-        keys[detail->long_name()] = hash;
-      }
-    }
-
-    assert(stop_on_positional_ || argc == current || argc == 0);
+    assert(stopped_ || stop_on_positional_ || argc == current || argc == 0);
 
-    return parse_result(std::move(keys), std::move(parsed_),
-                        std::move(sequential_), std::move(unmatched), current);
+    result_.consumed_arguments_ = current;
   }
 
 private:
-  bool consume_positional(const std::string& arg,
+  bool consume_positional(const string_view arg,
                           positional_list_iterator& next) {
     for (; next != positional_.end(); ++next) {
-      const auto oi = options_.find(*next);
-      if (oi == options_.end()) {
-        detail::throw_or_mimic<option_not_exists_error>(*next);
+      const auto opt = index_.find(*next);
+      if (opt == nullptr) {
+        fail(parse_error_code::option_not_exists, *next);
+        continue;
       }
-      if (oi->second->value()->is_container()) {
-        parse_option(oi->second, arg);
+      if (opt->is_container()) {
+        parse_option(*opt, arg);
         return true;
       }
-      if (parsed_[oi->second->hash()].count() == 0) {
-        parse_option(oi->second, arg);
+      if (parsed_[opt->id()].count() == 0) {
+        parse_option(*opt, arg);
         ++next;
         return true;
       }
@@ -1455,11 +4394,6 @@ private:
     return false;
   }
 
-  bool is_dash_dash(const char* str) const noexcept {
-    return (str[0] != 0 && str[0] == '-') && (str[1] != 0 && str[1] == '-') &&
-           (str[2] == 0);
-  }
-
   bool is_dash_dash_or_option_name(const char* const arg) const {
     // The dash-dash symbol has a special meaning and cannot
     // be interpreted as an option value.
@@ -1474,115 +4408,169 @@ private:
       return false;
     }
 
-    auto check_name = [this](const std::string& opt) {
-      return options_.find(opt) != options_.end();
-    };
     // Check that the argument does not match any
     // existing option.
     if (result.is_long) {
-      return check_name(result.name);
+      return index_.find(result.name.data(), result.name.size()) != nullptr;
     } else {
-      return check_name(result.name.substr(0, 1));
+      return index_.find(result.name[0]) != nullptr;
     }
-
-    return false;
   }
 
   void checked_parse_arg(const int argc,
                          const char* const* argv,
                          int& current,
-                         const std::shared_ptr<option_details>& value,
-                         const std::string& name) {
-    auto parse_implicit = [&]() {
-      if (value->has_implicit()) {
-        parse_option(value, value->implicit_value());
+                         const option_details& value,
+                         const string_view name) {
+    auto use_implicit = [&]() {
+      if (value.has_implicit()) {
+        parse_implicit(value);
       } else {
-        detail::throw_or_mimic<missing_argument_error>(name);
+        fail(parse_error_code::missing_argument, name);
       }
     };
 
-    if (current + 1 == argc || value->value()->get_no_value()) {
+    if (current + 1 == argc || value.value()->get_no_value()) {
       // Last argument or the option without value.
-      parse_implicit();
+      use_implicit();
     } else {
       const char* const arg = argv[current + 1];
       // Check that we do not silently consume any option as a value
       // of another option.
       if (arg[0] == '-' && is_dash_dash_or_option_name(arg)) {
-        parse_implicit();
+        use_implicit();
       } else {
         // Parse argument as a value for the option.
-        parse_option(value, arg);
         ++current;
+        argument_index_ = current;
+        parse_option(value, arg);
       }
     }
   }
 
-  bool parse_argument(const std::string& text, option_data& data) const {
-    const char* p = text.c_str();
-    const char* end = text.c_str() + text.size();
-    // The string should be at least two character long and starts with '-'.
-    if (*p == 0 || *(p + 1) == 0 || *p != '-') {
-      return false;
+  void add_unmatched(const char* text, const int index, const bool fragment) {
+    // Only one of the lists is filled, as asked by the specification.
+    if (copy_unmatched_) {
+      unmatched_.push_back(
+        parse_result::unmatched_argument(text, index, fragment).str());
+    } else {
+      unmatched_arguments_.emplace_back(text, index, fragment);
     }
-    // Skip the '-'.
-    ++p;
-    // Long option starts with '--'.
-    if (*p == '-') {
-      ++p;
-      if (std::isalnum(*p) && *(p + 1) != 0) {
-        data.is_long = true;
-        data.name += *p;
-        ++p;
-      } else {
-        return false;
-      }
-      for (; *p; ++p) {
-        if (*p == '=') {
-          ++p;
-          data.has_value = true;
-          data.value.assign(p, end);
-          break;
-        }
-        if (*p == '-' || *p == '_' || *p == '.' || std::isalnum(*p)) {
-          data.name += *p;
-        } else {
-          return false;
-        }
-      }
-      return data.name.size() > 1;
+  }
+
+  void parse_option(const option_details& details, const string_view arg) {
+    if (is_lazy(details)) {
+      defer_argument(details, arg);
+      return;
+    }
+    if (failures_ == nullptr) {
+      parsed_[details.id()].parse(details, arg);
+    } else if (!parsed_[details.id()].try_parse(details, arg)) {
+      fail(parse_error_code::incorrect_argument, arg, &details);
+      return;
+    }
+    add_argument(details, arg);
+  }
+
+  void parse_implicit(const option_details& details) {
+    const auto& text = details.implicit_value();
+
+    if (is_lazy(details)) {
+      defer_argument(details, text);
     } else {
-      // Single char short option should start with an alnum or
-      // be a question mark.
-      if (!(std::isalnum(*p) || (*p == '?' && *(p + 1) == 0))) {
-        return false;
-      }
-      // Copy the whole string and interpret it later as
-      // a group of short options.
-      data.name.assign(p, end);
-      return true;
+      parsed_[details.id()].parse_implicit(details);
+      add_argument(details, text);
     }
-    return false;
   }
 
-  void parse_option(const std::shared_ptr<option_details>& details,
-                    const std::string& arg) {
-    parsed_[details->hash()].parse(*details, arg);
-    sequential_.emplace_back(details->canonical_name(), arg);
+  void add_argument(const option_details& details, const string_view arg) {
+    parse_result::add_argument(sequential_, *values_, details, arg);
+  }
+
+  /// Lists the argument and defers conversion of the value to its text
+  /// in the buffer.
+  void defer_argument(const option_details& details, const string_view arg) {
+    const auto offset = values_->size();
+    add_argument(details, arg);
+    parsed_[details.id()].defer(details, result_.deferred_, offset,
+                                arg.size());
+  }
+
+  bool is_lazy(const option_details& details) const noexcept {
+    // Values bound to variables are always written immediately. Values
+    // are converted immediately when errors are collected, so that
+    // errors of conversion are collected too.
+    return lazy_conversion_ && failures_ == nullptr &&
+           !details.value()->is_bound();
+  }
+
+  /**
+   * Reports an error at the current argument. Throws unless errors
+   * are collected.
+   */
+  void fail(const parse_error_code code,
+            const string_view arg,
+            const option_details* option = nullptr) {
+    if (failures_ == nullptr) {
+      switch (code) {
+        case parse_error_code::option_syntax:
+          throw_or_mimic<option_syntax_error>(to_string(arg));
+        case parse_error_code::option_not_exists:
+          throw_or_mimic<option_not_exists_error>(to_string(arg));
+        case parse_error_code::missing_argument:
+          throw_or_mimic<missing_argument_error>(to_string(arg));
+        case parse_error_code::incorrect_argument:
+          throw_or_mimic<argument_incorrect_type>(to_string(arg));
+      }
+    }
+    failures_->emplace_back(code, argument_index_, to_string(arg),
+                            option ? option->canonical_name() : std::string());
+    stopped_ = !collect_all_;
   }
 
 private:
-  const option_map& options_;
+  const option_index& index_;
   const positional_list& positional_;
   const bool allow_unrecognised_;
   const bool stop_on_positional_;
-
-  std::vector<parse_result::key_value> sequential_{};
-  parse_result::parsed_hash_map parsed_{};
+  const bool lazy_conversion_;
+  /// Copy unmatched arguments into strings.
+  const bool copy_unmatched_;
+
+  parse_result::value_list& parsed_;
+  detail::result_vector<parse_result::argument>& sequential_;
+  /// Buffer with the texts of the recognized options.
+  detail::result_string* values_{nullptr};
+  std::vector<std::string>& unmatched_;
+  detail::result_vector<parse_result::unmatched_argument>& unmatched_arguments_;
+  parse_result& result_;
+
+  /// List of errors, if errors are collected instead of thrown.
+  std::vector<parse_failure>* failures_{nullptr};
+  /// Continue parsing after an error.
+  bool collect_all_{false};
+  /// Parsing has been stopped by an error.
+  bool stopped_{false};
+  /// Index of the argument being parsed.
+  int argument_index_{0};
 };
 
 } // namespace detail
 
+#ifdef CXXOPTS_USE_THREADS
+/**
+ * Outcome of parsing of one command line in a batch.
+ */
+struct batch_result {
+  /// Parsed values. Valid only if there was no error.
+  parse_result result{};
+  /// Description of the error, if any.
+  std::string error{};
+  /// Parsing has failed.
+  bool failed{false};
+};
+#endif
+
 class options;
 
 class option {
@@ -1618,6 +4606,28 @@ public:
     std::vector<std::shared_ptr<option_details>> options{};
   };
 
+  /**
+   * Memory taken by a specification, in bytes by category.
+   */
+  struct memory_report {
+    /// Objects describing the options and lists of them. With an arena,
+    /// all memory taken from it, including the texts placed there.
+    std::size_t options{0};
+    /// Short and long names of the options.
+    std::size_t names{0};
+    /// Descriptions and argument help of the options.
+    std::size_t descriptions{0};
+    /// Tables for finding options by name, including the compiled one.
+    std::size_t lookup{0};
+    /// Groups, positional arguments and other texts of the help.
+    std::size_t help{0};
+
+    CXXOPTS_NODISCARD
+    std::size_t total() const noexcept {
+      return options + names + descriptions + lookup + help;
+    }
+  };
+
   class option_adder {
   public:
     option_adder(std::string group, options& options) noexcept
@@ -1632,12 +4642,13 @@ public:
                              const std::string arg_help = {}) {
       std::string s;
       std::string l;
-      if (parse_option_specifier(opts, s, l)) {
+      if (detail::parse_option_specifier(opts, s, l)) {
         assert(s.empty() || s.size() == 1);
         assert(l.empty() || l.size() > 1);
 
-        options_.add_option(group_, std::move(s), std::move(l), desc, value,
-                            std::move(arg_help));
+        options_.add_option(group_, std::move(s), std::move(l),
+                            options_.make_text(desc), value,
+                            options_.make_text(arg_help));
       } else {
         detail::throw_or_mimic<invalid_option_format_error>(opts);
       }
@@ -1645,58 +4656,66 @@ public:
     }
 
   private:
-    bool parse_option_specifier(const std::string& text,
-                                std::string& s,
-                                std::string& l) const {
-      const char* p = text.c_str();
-      if (*p == 0) {
-        return false;
-      } else {
-        s.clear();
-        l.clear();
-      }
-      // Short option.
-      if (*(p + 1) == 0 || *(p + 1) == ',') {
-        if (*p == '?' || std::isalnum(*p)) {
-          s = *p;
-          ++p;
-        } else {
-          return false;
-        }
-      }
-      // Skip comma.
-      if (*p == ',') {
-        if (s.empty()) {
-          return false;
-        }
-        ++p;
-      }
-      // Skip spaces.
-      while (*p && *p == ' ') {
-        ++p;
-      }
-      // Valid specifier without long option.
-      if (*p == 0) {
-        return true;
+    const std::string group_;
+    options& options_;
+  };
+
+  /**
+   * Adds options without copying their descriptions and argument help.
+   * The texts should have static storage duration, as string literals do,
+   * or otherwise outlive the specification and all its copies.
+   */
+  class static_option_adder {
+  public:
+    static_option_adder(std::string group, options& options) noexcept
+      : group_(std::move(group))
+      , options_(options) {
+    }
+
+    /**
+     * Only character arrays are accepted for the borrowed texts, so that
+     * temporary strings are rejected at compile time.
+     */
+    template <std::size_t N>
+    static_option_adder& operator()(
+      const string_view opts,
+      const char (&desc)[N],
+      const std::shared_ptr<detail::value_base>& value =
+        ::cxxopts::value<bool>()) {
+      return add(opts, string_view(desc), value, string_view());
+    }
+
+    template <std::size_t N, std::size_t M>
+    static_option_adder& operator()(
+      const string_view opts,
+      const char (&desc)[N],
+      const std::shared_ptr<detail::value_base>& value,
+      const char (&arg_help)[M]) {
+      return add(opts, string_view(desc), value, string_view(arg_help));
+    }
+
+  private:
+    static_option_adder& add(
+      const string_view opts,
+      const string_view desc,
+      const std::shared_ptr<detail::value_base>& value,
+      const string_view arg_help) {
+      std::string s;
+      std::string l;
+      if (detail::parse_option_specifier(detail::to_string(opts), s, l)) {
+        assert(s.empty() || s.size() == 1);
+        assert(l.empty() || l.size() > 1);
+
+        options_.add_option(group_, std::move(s), std::move(l),
+                            detail::spec_text::borrow(desc), value,
+                            detail::spec_text::borrow(arg_help));
       } else {
-        l.reserve((text.c_str() + text.size()) - p);
-      }
-      // First char of an option name should be alnum.
-      if (std::isalnum(*p)) {
-        l += *p;
-        ++p;
+        detail::throw_or_mimic<invalid_option_format_error>(
+          detail::to_string(opts));
       }
-      for (; *p; ++p) {
-        if (*p == '-' || *p == '_' || *p == '.' || std::isalnum(*p)) {
-          l += *p;
-        } else {
-          return false;
-        }
-      }
-      return l.size() > 1;
+      return *this;
     }
 
-  private:
     const std::string group_;
     options& options_;
   };
@@ -1731,6 +4750,42 @@ public:
     return option_adder(std::move(group), *this);
   }
 
+  /**
+   * Adds options whose descriptions and argument help are kept by
+   * reference, such as string literals:
+   *
+   *   options.add_static_options()
+   *     ("v,verbose", "Verbose output")
+   *     ("o,output", "Output file", cxxopts::value<std::string>(), "FILE");
+   */
+  static_option_adder add_static_options(std::string group = {}) {
+    return static_option_adder(std::move(group), *this);
+  }
+
+  /**
+   * Adds an option to the specific group and returns a handle
+   * for typed access to its value.
+   */
+  template <typename T>
+  option_handle<T> add_option(const std::string& group,
+                              const std::string& opts,
+                              const std::string& desc,
+                              const std::shared_ptr<detail::basic_value<T>>& value,
+                              std::string arg_help = {}) {
+    option_adder(group, *this)(opts, desc, value, std::move(arg_help));
+    return option_handle<T>(*option_list_.back());
+  }
+
+  /**
+   * Adds a boolean option to the specific group and returns a handle
+   * for typed access to its value.
+   */
+  option_handle<bool> add_option(const std::string& group,
+                                 const std::string& opts,
+                                 const std::string& desc) {
+    return add_option(group, opts, desc, ::cxxopts::value<bool>());
+  }
+
   options& allow_unrecognised_options(const bool value = true) noexcept {
     allow_unrecognised_ = value;
     return *this;
@@ -1746,6 +4801,41 @@ public:
     return *this;
   }
 
+  /**
+   * Defer conversion of values until they are accessed through
+   * option_value::as(). Errors of conversion are reported by as()
+   * instead of parse(). Values bound to variables are always
+   * converted immediately. Conversion is serialized by a lock of
+   * the result, so a result can be read by several threads. Values
+   * already converted are read without the lock.
+   * try_parse() converts values immediately to report their errors.
+   */
+  options& lazy_conversion(const bool value = true) noexcept {
+    lazy_conversion_ = value;
+    return *this;
+  }
+
+  /**
+   * Do not copy unmatched arguments into strings. parse_result::unmatched()
+   * stays empty, and the arguments are listed only by
+   * parse_result::unmatched_arguments(), which refers to argv.
+   */
+  options& view_unmatched(const bool value = true) noexcept {
+    copy_unmatched_ = !value;
+    return *this;
+  }
+
+  /**
+   * Place details of options added after the call in a single arena owned
+   * by the specification, together with copies of their descriptions and
+   * argument help. The arena is released at once when the specification
+   * and all parse results are destroyed.
+   */
+  options& use_arena(const bool value = true) {
+    arena_.reset(value);
+    return *this;
+  }
+
   template <typename... Args>
   void parse_positional(Args&&... args) {
     parse_positional(std::vector<std::string>{std::forward<Args>(args)...});
@@ -1793,16 +4883,156 @@ public:
     return *this;
   }
 
+  /**
+   * Builds an immutable lookup table over the defined options which will be
+   * used by subsequent calls of parse(). Without it, the table is built by
+   * the first call of parse(). Defining new options discards the table.
+   */
+  options& compile() {
+    index_.get(option_list_);
+    return *this;
+  }
+
 public:
   /**
    * Parses the command line arguments according to the current specification.
+   *
+   * Each call stores parsed values in the returned result, so the same
+   * specification may be used by several threads at once. Values bound to
+   * variables are still written to those variables.
    */
   parse_result parse(int argc, const char* const* argv) const {
-    return detail::option_parser(options_, positional_, allow_unrecognised_,
-                                 stop_on_positional_)
+    parse_result result;
+    parse(argc, argv, result);
+    return result;
+  }
+
+#ifdef CXXOPTS_HAS_MEMORY_RESOURCE
+  /**
+   * Parses the command line arguments into a result which allocates from
+   * the memory resource.
+   *
+   * The resource backs values of the options and the list of recognized
+   * options, so a monotonic buffer can hold the whole result and release
+   * it at once. The result, and the values shared by its copies, must not
+   * outlive the resource.
+   */
+  parse_result parse(int argc,
+                     const char* const* argv,
+                     std::pmr::memory_resource* resource) const {
+    parse_result result{parse_result::allocator_type(resource)};
+    parse(argc, argv, result);
+    return result;
+  }
+#endif
+
+  /**
+   * Parses the command line arguments into the existing result.
+   *
+   * Previous content of the result is replaced. If the result was filled
+   * by the same specification and no options were added since then, its
+   * containers and value storage are cleared and reused instead of being
+   * allocated again.
+   */
+  void parse(int argc, const char* const* argv, parse_result& result) const {
+    detail::option_parser(index_.get(option_list_), positional_,
+                          allow_unrecognised_, stop_on_positional_,
+                          lazy_conversion_, copy_unmatched_, result)
+      .parse(argc, argv);
+  }
+
+  /**
+   * Parses the command line arguments without throwing on invalid input.
+   *
+   * Errors are returned with the result instead of being thrown.
+   * Parsing stops at the first error unless all errors are requested.
+   * Conversion by custom value parsers, which can report errors only by
+   * exceptions, terminates the program on error without exception support.
+   */
+  parse_outcome try_parse(int argc,
+                          const char* const* argv,
+                          const bool all_errors = false) const {
+    parse_outcome outcome;
+    try_parse(argc, argv, outcome, all_errors);
+    return outcome;
+  }
+
+  /**
+   * Parses the command line arguments into the existing outcome without
+   * throwing on invalid input.
+   */
+  void try_parse(int argc,
+                 const char* const* argv,
+                 parse_outcome& outcome,
+                 const bool all_errors = false) const {
+    outcome.errors_.clear();
+    detail::option_parser(index_.get(option_list_), positional_,
+                          allow_unrecognised_, stop_on_positional_,
+                          lazy_conversion_, copy_unmatched_, outcome.result_)
+      .collect_errors(outcome.errors_, all_errors)
       .parse(argc, argv);
   }
 
+#ifdef CXXOPTS_USE_THREADS
+  /**
+   * Parses a sequence of command lines using a pool of threads.
+   *
+   * Each command line is a sequence of strings, the first of which is
+   * the program name, as in argv. Returns one entry per command line in
+   * the input order. Zero number of threads means the number of hardware
+   * threads. Errors are reported through the entries, as with try_parse().
+   *
+   * Values bound to variables would be written by several threads at once,
+   * so a specification with such values is parsed on the calling thread
+   * only. The variables keep the values of the last command line.
+   */
+  template <typename Commands>
+  std::vector<batch_result> parse_batch(const Commands& commands,
+                                        std::size_t threads = 0) const {
+    using command_type = typename std::remove_reference<decltype(
+      *std::begin(std::declval<const Commands&>()))>::type;
+
+    const auto index = index_.get(option_list_);
+    std::vector<const command_type*> lines;
+    for (const auto& command : commands) {
+      lines.push_back(&command);
+    }
+    std::vector<batch_result> results(lines.size());
+    std::atomic<std::size_t> next{0};
+
+    auto worker = [&]() {
+      std::vector<const char*> argv;
+
+      for (std::size_t i = next++; i < lines.size(); i = next++) {
+        argv.clear();
+        for (const auto& arg : *lines[i]) {
+          argv.push_back(detail::c_str(arg));
+        }
+        parse_batch_entry(index, argv, results[i]);
+      }
+    };
+
+    if (threads == 0) {
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, lines.size());
+    if (has_bound_values()) {
+      threads = 1;
+    }
+    // Spawn additional threads and use the current one as well.
+    std::vector<std::thread> pool;
+    for (std::size_t i = 1; i < threads; ++i) {
+      pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+      thread.join();
+    }
+
+    return results;
+  }
+#endif
+
   /**
    * Generates help for the options.
    */
@@ -1850,8 +5080,65 @@ public:
     return group_names_;
   }
 
-  const help_group_details& group_help(const std::string& group) const {
-    return help_.at(group);
+  /**
+   * Returns options of the group. Throws std::out_of_range if there is
+   * no such group.
+   */
+  help_group_details group_help(const std::string& group) const {
+    const auto id = find_group(group);
+    if (id == group_names_.size()) {
+      detail::throw_or_mimic<std::out_of_range>(group);
+    }
+
+    help_group_details details;
+    details.name = group;
+    for (std::size_t i = 0; i != option_list_.size(); ++i) {
+      if (option_groups_[i] == id) {
+        details.options.push_back(option_list_[i]);
+      }
+    }
+    return details;
+  }
+
+  /**
+   * Estimates memory taken by the specification. Value objects passed
+   * to add_options() and overheads of the allocator are not counted.
+   */
+  CXXOPTS_NODISCARD
+  memory_report memory_usage() const {
+    memory_report report;
+
+    report.options =
+      option_list_.capacity() * sizeof(option_list_.front()) +
+      option_groups_.capacity() * sizeof(uint32_t) +
+      (arena_.get() ? arena_.get()->allocated()
+                    : option_list_.size() * sizeof(option_details));
+    for (const auto& o : option_list_) {
+      report.names += detail::heap_size(o->short_name()) +
+                      detail::heap_size(o->long_name());
+      report.descriptions += o->desc_.heap_size() + o->arg_help_.heap_size();
+    }
+    const auto index = index_.get();
+    report.lookup =
+      names_.memory_usage() + (index ? index->memory_usage() : 0);
+
+    report.help = detail::heap_size(program_) +
+                  detail::heap_size(help_string_) +
+                  detail::heap_size(custom_help_) +
+                  detail::heap_size(positional_help_) +
+                  detail::heap_size(footer_) +
+                  group_names_.capacity() * sizeof(std::string) +
+                  positional_.capacity() * sizeof(std::string) +
+                  positional_set_.bucket_count() * sizeof(void*) +
+                  positional_set_.size() * (sizeof(std::string) + sizeof(void*));
+    for (const auto& name : group_names_) {
+      report.help += detail::heap_size(name);
+    }
+    for (const auto& name : positional_) {
+      report.help += 2 * detail::heap_size(name);
+    }
+
+    return report;
   }
 
   const std::string& program() const noexcept {
@@ -1859,37 +5146,87 @@ public:
   }
 
 private:
+  /// Copies text of an option into the arena, if there is one.
+  detail::spec_text make_text(const std::string& text) const {
+    if (const auto& a = arena_.get()) {
+      return detail::spec_text::borrow(a->copy(text));
+    }
+    return detail::spec_text(text);
+  }
+
   void add_option(const std::string& group,
-                  const std::string& s,
-                  const std::string& l,
-                  std::string desc,
+                  std::string s,
+                  std::string l,
+                  detail::spec_text desc,
                   const std::shared_ptr<detail::value_base>& value,
-                  std::string arg_help) {
-    auto details = std::make_shared<option_details>(
-      s, l, std::move(arg_help), to_local_string(std::move(desc)), value);
-
-    if (!s.empty()) {
-      add_one_option(s, details);
+                  detail::spec_text arg_help) {
+    // Invalid default or implicit values are reported here rather than
+    // on each parse.
+    value->prepare();
+    // The lookup table does not cover the new option.
+    index_.reset();
+
+    if (!s.empty() && names_.contains(option_list_, s)) {
+      detail::throw_or_mimic<option_exists_error>(s);
     }
-    if (!l.empty()) {
-      add_one_option(l, details);
+    if (!l.empty() && names_.contains(option_list_, l)) {
+      detail::throw_or_mimic<option_exists_error>(l);
     }
 
-    if (help_.find(group) == help_.end()) {
+    const auto group_id = find_group(group);
+    if (group_id == group_names_.size()) {
       group_names_.push_back(group);
     }
-    // Add the help details.
-    help_[group].options.push_back(std::move(details));
+
+    option_list_.push_back(std::allocate_shared<option_details>(
+      detail::arena_allocator<option_details>(arena_.get()), std::move(s),
+      std::move(l), std::move(arg_help), std::move(desc), value,
+      option_list_.size()));
+    option_groups_.push_back(static_cast<uint32_t>(group_id));
+    names_.insert(option_list_, option_list_.size() - 1);
+  }
+
+  std::size_t find_group(const std::string& group) const noexcept {
+    return static_cast<std::size_t>(
+      std::find(group_names_.begin(), group_names_.end(), group) -
+      group_names_.begin());
   }
 
-  void add_one_option(const std::string& name,
-                      const std::shared_ptr<option_details>& details) {
-    const auto in = options_.emplace(name, details);
+#ifdef CXXOPTS_USE_THREADS
+  bool has_bound_values() const noexcept {
+    for (const auto& o : option_list_) {
+      if (o->value()->is_bound()) {
+        return true;
+      }
+    }
+    return false;
+  }
 
-    if (!in.second) {
-      detail::throw_or_mimic<option_exists_error>(name);
+  void parse_batch_entry(const std::shared_ptr<const detail::option_index>& index,
+                         const std::vector<const char*>& argv,
+                         batch_result& entry) const {
+    std::vector<parse_failure> failures;
+#ifndef CXXOPTS_NO_EXCEPTIONS
+    try {
+#endif
+      detail::option_parser(index, positional_, allow_unrecognised_,
+                            stop_on_positional_, lazy_conversion_,
+                            copy_unmatched_, entry.result)
+        .collect_errors(failures, false)
+        .parse(static_cast<int>(argv.size()), argv.data());
+#ifndef CXXOPTS_NO_EXCEPTIONS
+    } catch (const std::exception& e) {
+      entry.failed = true;
+      entry.error = e.what();
+      return;
+    }
+#endif
+    if (!failures.empty()) {
+      entry.failed = true;
+      entry.error = failures.front().message();
     }
   }
+#endif
 
   cxx_string format_option(const option_details& o) const {
     const auto& s = o.short_name();
@@ -1913,8 +5250,9 @@ private:
     }
 
     if (!o.is_boolean()) {
-      const auto arg =
-        !o.arg_help().empty() ? to_local_string(o.arg_help()) : "arg";
+      const auto arg = !o.arg_help_view().empty()
+                         ? make_local_string(o.arg_help_view())
+                         : "arg";
 
       if (o.has_implicit()) {
         result += " [=";
@@ -1935,7 +5273,7 @@ private:
                                 std::size_t start,
                                 std::size_t allowed,
                                 bool tab_expansion) const {
-    cxx_string desc = o.description();
+    cxx_string desc = make_local_string(o.description_view());
 
     if (o.has_default() && (!o.is_boolean() || o.default_value() != "false")) {
       if (!o.default_value().empty()) {
@@ -1956,8 +5294,8 @@ private:
     using option_help =
       std::vector<std::pair<cxx_string, const option_details*>>;
 
-    const auto gi = help_.find(group_name);
-    if (gi == help_.end()) {
+    const auto group_id = find_group(group_name);
+    if (group_id == group_names_.size()) {
       return cxx_string();
     }
 
@@ -1970,10 +5308,15 @@ private:
       result += '\n';
     }
     // Preallocate buffer for list of options.
-    format.reserve(gi->second.options.size() -
-                   (show_positional_ ? 0 : positional_set_.size()));
+    format.reserve(static_cast<std::size_t>(
+      std::count(option_groups_.begin(), option_groups_.end(), group_id)));
+
+    for (std::size_t i = 0; i != option_list_.size(); ++i) {
+      if (option_groups_[i] != group_id) {
+        continue;
+      }
 
-    for (const auto& o : gi->second.options) {
+      const auto& o = option_list_[i];
       if (!show_positional_ &&
           positional_set_.find(o->long_name()) != positional_set_.end())
       {
@@ -2137,8 +5480,6 @@ private:
   }
 
 private:
-  using option_map =
-    std::unordered_map<std::string, std::shared_ptr<option_details>>;
   using positional_list = std::vector<std::string>;
 
   std::string program_;
@@ -2154,22 +5495,632 @@ private:
   bool show_positional_{false};
   /// Stop parsing at first positional argument.
   bool stop_on_positional_{false};
+  /// Defer conversion of values until they are accessed.
+  bool lazy_conversion_{false};
+  /// Copy unmatched arguments into strings of the result.
+  bool copy_unmatched_{true};
   /// Replace tab with spaces.
   bool tab_expansion_{false};
 
-  /// Named options.
-  /// Short and long names exist as separate entries but
-  /// point to the same object.
-  option_map options_{};
+  /// Arena for details of options, if enabled.
+  detail::arena_holder arena_{};
+  /// Short and long names of all options.
+  detail::name_table names_{};
+  /// Options in order of registration.
+  detail::option_index::option_list option_list_{};
+  /// Positions of groups of the options in the list of groups, indexed
+  /// by identifiers of the options.
+  std::vector<uint32_t> option_groups_{};
+  /// Lookup table built by compile() or the first parse.
+  detail::index_cache index_{};
   /// List of named positional arguments.
   positional_list positional_{};
   std::unordered_set<std::string> positional_set_{};
-  /// Mapping from groups to help options.
-  std::map<std::string, help_group_details> help_{};
   /// Unique names of groups in order defined by user.
   std::vector<std::string> group_names_{};
 };
 
+/**
+ * Options bound to fields of a structure. The specification is a single
+ * table of fields, each with a pointer to the member and a conversion
+ * function for its type, so no value object is created per option and
+ * values are written directly into the structure.
+ *
+ *   struct config {
+ *     bool verbose = false;
+ *     int threads = 1;
+ *   };
+ *
+ *   cxxopts::struct_options<config> options("program");
+ *   options.add_options()
+ *     ("v,verbose", "Verbose output", &config::verbose)
+ *     ("n,threads", "Number of threads", &config::threads);
+ *
+ *   config cfg;
+ *   options.parse(argc, argv, cfg);
+ *
+ * Fields of type bool are flags, other fields take a value. Fields keep
+ * their values if options are not given, and values of vector fields are
+ * appended to the existing elements.
+ */
+template <typename S>
+class struct_options {
+  /// Pointer to a member of any type stored as bytes.
+  using member_storage = std::array<unsigned char, sizeof(char S::*)>;
+
+  using parse_fn = void (*)(const parse_context&,
+                            string_view,
+                            S&,
+                            const member_storage&);
+  using describe_fn = void (*)(options&,
+                               const std::string& group,
+                               const std::string& specifier,
+                               const std::string& desc,
+                               const std::string& arg_help);
+
+  struct field {
+    std::string long_name;
+    std::string desc;
+    std::string arg_help;
+    member_storage member;
+    parse_fn parse;
+    describe_fn describe;
+    std::size_t group;
+    char short_name;
+    bool is_flag;
+  };
+
+public:
+  class field_adder {
+  public:
+    field_adder(const std::size_t group, struct_options& owner) noexcept
+      : group_(group)
+      , owner_(owner) {
+    }
+
+    template <typename T>
+    field_adder& operator()(const std::string& opts,
+                            const std::string& desc,
+                            T S::*member,
+                            const std::string& arg_help = {}) {
+      owner_.add_field(group_, opts, desc, member, arg_help);
+      return *this;
+    }
+
+  private:
+    const std::size_t group_;
+    struct_options& owner_;
+  };
+
+  explicit struct_options(std::string program, std::string help_string = {})
+    : program_(std::move(program))
+    , help_string_(std::move(help_string)) {
+    for (auto& id : short_index_) {
+      id = npos;
+    }
+  }
+
+  /**
+   * Adds list of options to the specific group.
+   */
+  field_adder add_options(const std::string& group = {}) {
+    const auto index = static_cast<std::size_t>(
+      std::find(group_names_.begin(), group_names_.end(), group) -
+      group_names_.begin());
+    if (index == group_names_.size()) {
+      group_names_.push_back(group);
+    }
+    return field_adder(index, *this);
+  }
+
+  /**
+   * Parses arguments into the structure. Returns arguments which are not
+   * consumed by options; they refer to the strings of argv.
+   */
+  std::vector<string_view> parse(const int argc,
+                                 const char* const* argv,
+                                 S& target,
+                                 const parse_context& ctx = {}) const {
+    std::vector<string_view> unmatched;
+    handler h{*this, target, ctx};
+    detail::parse_plain(argc, argv, h, unmatched);
+    return unmatched;
+  }
+
+  /**
+   * Formats help in the same way as options::help().
+   */
+  std::string help(const std::vector<std::string>& help_groups = {}) const {
+    options opts(program_, help_string_);
+    for (const auto& f : fields_) {
+      std::string specifier;
+      if (f.short_name) {
+        specifier += f.short_name;
+        specifier += ',';
+      }
+      specifier += f.long_name;
+
+      f.describe(opts, group_names_[f.group], specifier, f.desc, f.arg_help);
+    }
+    return opts.help(help_groups);
+  }
+
+  /**
+   * Returns list of the defined groups.
+   */
+  std::vector<std::string> groups() const {
+    return group_names_;
+  }
+
+  /**
+   * Number of options.
+   */
+  std::size_t size() const noexcept {
+    return fields_.size();
+  }
+
+private:
+  static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+  struct handler {
+    const struct_options& spec;
+    S& target;
+    const parse_context& ctx;
+
+    bool find(const string_view name, std::size_t& index) const {
+      return spec.find(name, index);
+    }
+
+    bool find(const char name, std::size_t& index) const noexcept {
+      return spec.find(name, index);
+    }
+
+    bool is_flag(const std::size_t index) const noexcept {
+      return spec.fields_[index].is_flag;
+    }
+
+    void assign(const std::size_t index, const string_view text) const {
+      const auto& f = spec.fields_[index];
+      f.parse(ctx, text, target, f.member);
+    }
+  };
+
+  template <typename T>
+  static void parse_field(const parse_context& ctx,
+                          const string_view text,
+                          S& target,
+                          const member_storage& member) {
+    T S::*ptr = nullptr;
+    std::memcpy(&ptr, member.data(), sizeof(ptr));
+    detail::convert_value(ctx, text, target.*ptr);
+  }
+
+  template <typename T>
+  static void describe_field(options& opts,
+                             const std::string& group,
+                             const std::string& specifier,
+                             const std::string& desc,
+                             const std::string& arg_help) {
+    opts.add_options(group)(specifier, desc, value<T>(), arg_help);
+  }
+
+  template <typename T>
+  void add_field(const std::size_t group,
+                 const std::string& opts,
+                 const std::string& desc,
+                 T S::*member,
+                 const std::string& arg_help) {
+    static_assert(sizeof(member) == sizeof(member_storage),
+                  "unsupported pointer to member");
+
+    std::string s;
+    std::string l;
+    if (!detail::parse_option_specifier(opts, s, l) ||
+        (!s.empty() && static_cast<unsigned char>(s[0]) >= short_index_.size()))
+    {
+      detail::throw_or_mimic<invalid_option_format_error>(opts);
+    }
+
+    std::size_t existing = 0;
+    if (!s.empty() && find(s[0], existing)) {
+      detail::throw_or_mimic<option_exists_error>(s);
+    }
+    const auto li = std::lower_bound(
+      long_index_.begin(), long_index_.end(), l,
+      [this](const uint32_t i, const std::string& name) {
+        return fields_[i].long_name < name;
+      });
+    if (!l.empty() && li != long_index_.end() && fields_[*li].long_name == l) {
+      detail::throw_or_mimic<option_exists_error>(l);
+    }
+
+    const auto index = static_cast<uint32_t>(fields_.size());
+
+    field f{std::move(l), desc, arg_help, member_storage{},
+            &parse_field<T>, &describe_field<T>, group,
+            s.empty() ? '\0' : s[0], std::is_same<T, bool>::value};
+    std::memcpy(f.member.data(), &member, sizeof(member));
+    fields_.push_back(std::move(f));
+
+    if (!fields_.back().long_name.empty()) {
+      long_index_.insert(li, index);
+    }
+    if (!s.empty()) {
+      short_index_[static_cast<unsigned char>(s[0])] = index;
+    }
+  }
+
+  bool find(const string_view name, std::size_t& index) const {
+    const auto it = std::lower_bound(
+      long_index_.begin(), long_index_.end(), name,
+      [this](const uint32_t i, const string_view n) {
+        return fields_[i].long_name.compare(0, std::string::npos, n.data(),
+                                            n.size()) < 0;
+      });
+    if (it == long_index_.end() || fields_[*it].long_name != name) {
+      return false;
+    }
+    index = *it;
+    return true;
+  }
+
+  bool find(const char name, std::size_t& index) const noexcept {
+    const auto c = static_cast<unsigned char>(name);
+    if (c >= short_index_.size() || short_index_[c] == npos) {
+      return false;
+    }
+    index = short_index_[c];
+    return true;
+  }
+
+private:
+  std::string program_;
+  std::string help_string_;
+  /// Options in order of registration.
+  std::vector<field> fields_{};
+  /// Indices of options with long names sorted by name.
+  std::vector<uint32_t> long_index_{};
+  /// Indices of options by short name.
+  std::array<uint32_t, 128> short_index_{};
+  /// Unique names of groups in order defined by user.
+  std::vector<std::string> group_names_{};
+};
+
+} // namespace cxxopts
+
+#ifdef CXXOPTS_HAS_STATIC_OPTIONS
+
+/**
+ * \defgroup Static options
+ * @{
+ */
+
+namespace cxxopts {
+namespace detail {
+
+/**
+ * A string literal usable as a template argument.
+ */
+template <std::size_t N>
+struct fixed_string {
+  constexpr fixed_string(const char (&str)[N]) noexcept {
+    std::copy_n(str, N, data);
+  }
+
+  constexpr string_view view() const noexcept {
+    return string_view(data, N - 1);
+  }
+
+  char data[N]{};
+};
+
+/// Names of an option declared at compile time.
+struct static_names {
+  char short_name{0};
+  string_view long_name{};
+  bool valid{false};
+};
+
+constexpr bool is_ascii_alnum(const char c) noexcept {
+  return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') ||
+         (c >= 'A' && c <= 'Z');
+}
+
+/**
+ * Compile-time counterpart of the runtime parse_option_specifier().
+ */
+constexpr static_names parse_option_specifier(const string_view text) noexcept {
+  static_names names{};
+  std::size_t p = 0;
+
+  if (text.empty()) {
+    return names;
+  }
+  // Short option.
+  if (text.size() == 1 || text[1] == ',') {
+    if (text[0] == '?' || is_ascii_alnum(text[0])) {
+      names.short_name = text[0];
+      ++p;
+    } else {
+      return names;
+    }
+  }
+  // Skip comma.
+  if (p < text.size() && text[p] == ',') {
+    if (names.short_name == 0) {
+      return names;
+    }
+    ++p;
+  }
+  // Skip spaces.
+  while (p < text.size() && text[p] == ' ') {
+    ++p;
+  }
+  // Valid specifier without long option.
+  if (p == text.size()) {
+    names.valid = true;
+    return names;
+  }
+  // First char of an option name should be alnum.
+  if (!is_ascii_alnum(text[p])) {
+    return names;
+  }
+  for (std::size_t i = p + 1; i != text.size(); ++i) {
+    const char c = text[i];
+    if (!(c == '-' || c == '_' || c == '.' || is_ascii_alnum(c))) {
+      return names;
+    }
+  }
+  names.long_name = text.substr(p);
+  names.valid = names.long_name.size() > 1;
+  return names;
+}
+
+/**
+ * Lookup tables of a set of options declared at compile time.
+ */
+template <typename... Opts>
+struct static_spec {
+  static constexpr std::size_t size = sizeof...(Opts);
+
+  static constexpr std::array<static_names, size> names{{Opts::names...}};
+
+  /// Options which do not take a value.
+  static constexpr std::array<bool, size> is_flag{
+    {std::is_same<typename Opts::value_type, bool>::value...}};
+
+  struct long_entry {
+    string_view name;
+    std::size_t index;
+  };
+
+  static constexpr bool has_unique_names() noexcept {
+    for (std::size_t i = 0; i != size; ++i) {
+      for (std::size_t j = i + 1; j != size; ++j) {
+        if (names[i].short_name && names[i].short_name == names[j].short_name) {
+          return false;
+        }
+        if (!names[i].long_name.empty() &&
+            names[i].long_name == names[j].long_name)
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  static_assert(has_unique_names(), "option names must be unique");
+
+  static constexpr std::size_t long_count() noexcept {
+    std::size_t count = 0;
+    for (const auto& n : names) {
+      count += n.long_name.empty() ? 0 : 1;
+    }
+    return count;
+  }
+
+  /// Long names sorted for binary search.
+  static constexpr auto long_index = [] {
+    std::array<long_entry, long_count()> table{};
+    std::size_t count = 0;
+    for (std::size_t i = 0; i != size; ++i) {
+      if (!names[i].long_name.empty()) {
+        table[count++] = long_entry{names[i].long_name, i};
+      }
+    }
+    std::sort(table.begin(), table.end(),
+              [](const long_entry& a, const long_entry& b) {
+                return a.name < b.name;
+              });
+    return table;
+  }();
+
+  /// Direct mapping from short names to options.
+  static constexpr auto short_index = [] {
+    std::array<std::size_t, 128> table{};
+    table.fill(size);
+    for (std::size_t i = 0; i != size; ++i) {
+      if (names[i].short_name) {
+        table[static_cast<unsigned char>(names[i].short_name)] = i;
+      }
+    }
+    return table;
+  }();
+
+  /// Returns position of the option or size if there is no such option.
+  static constexpr std::size_t index_of(const string_view name) noexcept {
+    for (std::size_t i = 0; i != size; ++i) {
+      if (names[i].long_name == name ||
+          (name.size() == 1 && names[i].short_name == name[0]))
+      {
+        return i;
+      }
+    }
+    return size;
+  }
+
+  static std::size_t find(const string_view name) noexcept {
+    const auto it =
+      std::lower_bound(long_index.begin(), long_index.end(), name,
+                       [](const long_entry& e, const string_view n) {
+                         return e.name < n;
+                       });
+    return (it != long_index.end() && it->name == name) ? it->index : size;
+  }
+
+  static std::size_t find(const char name) noexcept {
+    const auto c = static_cast<unsigned char>(name);
+    return c < short_index.size() ? short_index[c] : size;
+  }
+};
+
+} // namespace detail
+
+/**
+ * An option declared at compile time. The specifier has the same format
+ * as in options::add_options(); options of type bool do not take a value.
+ */
+template <detail::fixed_string Spec, typename T = bool>
+struct opt {
+  using value_type = T;
+
+  static constexpr detail::static_names names =
+    detail::parse_option_specifier(Spec.view());
+
+  static_assert(names.valid, "invalid option specifier");
+};
+
+template <typename... Opts>
+class static_options;
+
+/**
+ * Values of options declared at compile time. Each option is stored as
+ * a field of its own type.
+ */
+template <typename... Opts>
+class static_result {
+  using spec = detail::static_spec<Opts...>;
+
+public:
+  template <detail::fixed_string Name>
+  CXXOPTS_NODISCARD const auto& get() const noexcept {
+    return std::get<index<Name>()>(values_);
+  }
+
+  template <detail::fixed_string Name>
+  CXXOPTS_NODISCARD std::size_t count() const noexcept {
+    return counts_[index<Name>()];
+  }
+
+  /**
+   * Arguments which are not consumed by options. They refer to
+   * the strings of argv.
+   */
+  CXXOPTS_NODISCARD
+  const std::vector<string_view>& unmatched() const noexcept {
+    return unmatched_;
+  }
+
+private:
+  template <typename...>
+  friend class static_options;
+
+  template <detail::fixed_string Name>
+  static constexpr std::size_t index() noexcept {
+    constexpr auto i = spec::index_of(Name.view());
+    static_assert(i != spec::size, "option does not exist");
+    return i;
+  }
+
+  std::tuple<typename Opts::value_type...> values_{};
+  std::array<std::size_t, sizeof...(Opts)> counts_{};
+  std::vector<string_view> unmatched_{};
+};
+
+/**
+ * A parser of options declared at compile time. Names are resolved through
+ * tables built by the compiler and values are converted directly into typed
+ * fields, without allocating a specification at run time.
+ *
+ *   using cli = cxxopts::static_options<
+ *     cxxopts::opt<"v,verbose">,
+ *     cxxopts::opt<"n,num", int>>;
+ *
+ *   const auto result = cli::parse(argc, argv);
+ *   int num = result.get<"num">();
+ */
+template <typename... Opts>
+class static_options {
+  using spec = detail::static_spec<Opts...>;
+
+public:
+  using result = static_result<Opts...>;
+
+  CXXOPTS_NODISCARD
+  static result parse(const int argc,
+                      const char* const* argv,
+                      const parse_context& ctx = {}) {
+    result r;
+    parse(argc, argv, r, ctx);
+    return r;
+  }
+
+  static void parse(const int argc,
+                    const char* const* argv,
+                    result& r,
+                    const parse_context& ctx = {}) {
+    r.values_ = {};
+    r.counts_ = {};
+    r.unmatched_.clear();
+
+    handler h{r, ctx};
+    detail::parse_plain(argc, argv, h, r.unmatched_);
+  }
+
+private:
+  struct handler {
+    result& r;
+    const parse_context& ctx;
+
+    bool find(const string_view name, std::size_t& index) const noexcept {
+      index = spec::find(name);
+      return index != spec::size;
+    }
+
+    bool find(const char name, std::size_t& index) const noexcept {
+      index = spec::find(name);
+      return index != spec::size;
+    }
+
+    bool is_flag(const std::size_t index) const noexcept {
+      return spec::is_flag[index];
+    }
+
+    void assign(const std::size_t index, const string_view text) {
+      assign(index, text, std::index_sequence_for<Opts...>());
+    }
+
+    template <std::size_t... I>
+    void assign(const std::size_t index,
+                const string_view text,
+                std::index_sequence<I...>) {
+      // Compiled into a jump table over the fields.
+      static_cast<void>(((index == I && (assign<I>(text), true)) || ...));
+    }
+
+    template <std::size_t I>
+    void assign(const string_view text) {
+      detail::convert_value(ctx, text, std::get<I>(r.values_));
+      ++r.counts_[I];
+    }
+  };
+};
+
 } // namespace cxxopts
 
+/**@}*/
+
+#endif // CXXOPTS_HAS_STATIC_OPTIONS
+
 #endif // CXXOPTS_HPP_INCLUDED
@@ -0,0 +1,50 @@
+// Command line arguments for tests.
+
+#ifndef CXXOPTS_TEST_ARGV_HPP
+#define CXXOPTS_TEST_ARGV_HPP
+
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+namespace {
+
+class Argv {
+public:
+  Argv(std::initializer_list<const char*> args)
+    : argc_(static_cast<int>(args.size()))
+    , argv_(new const char*[args.size()])
+  {
+    int i = 0;
+    auto iter = args.begin();
+    while (iter != args.end()) {
+      auto len = strlen(*iter) + 1;
+      auto ptr = std::unique_ptr<char[]>(new char[len]);
+
+      strcpy(ptr.get(), *iter);
+      args_.push_back(std::move(ptr));
+      argv_.get()[i] = args_.back().get();
+
+      ++iter;
+      ++i;
+    }
+  }
+
+  const char** argv() const {
+    return argv_.get();
+  }
+
+  int argc() const {
+    return argc_;
+  }
+
+private:
+  const int argc_;
+  std::unique_ptr<const char*[]> argv_{};
+  std::vector<std::unique_ptr<char[]>> args_{};
+};
+
+} // namespace
+
+#endif // CXXOPTS_TEST_ARGV_HPP
@@ -1,47 +1,15 @@
 #include "catch.hpp"
 #include "cxxopts.hpp"
+#include "argv.hpp"
 
+#include <clocale>
+#include <cstdio>
 #include <cstring>
 #include <initializer_list>
 #include <list>
 
 namespace {
 
-class Argv {
-public:
-  Argv(std::initializer_list<const char*> args)
-    : argc_(static_cast<int>(args.size()))
-    , argv_(new const char*[args.size()])
-  {
-    int i = 0;
-    auto iter = args.begin();
-    while (iter != args.end()) {
-      auto len = strlen(*iter) + 1;
-      auto ptr = std::unique_ptr<char[]>(new char[len]);
-
-      strcpy(ptr.get(), *iter);
-      args_.push_back(std::move(ptr));
-      argv_.get()[i] = args_.back().get();
-
-      ++iter;
-      ++i;
-    }
-  }
-
-  const char** argv() const {
-    return argv_.get();
-  }
-
-  int argc() const {
-    return argc_;
-  }
-
-private:
-  const int argc_;
-  std::unique_ptr<const char*[]> argv_{};
-  std::vector<std::unique_ptr<char[]>> args_{};
-};
-
 template <typename T>
 bool validate_value_parser(const std::string& text, T&& expected) {
   T value;
@@ -49,6 +17,28 @@ bool validate_value_parser(const std::string& text, T&& expected) {
   return value == expected;
 }
 
+template <typename Desc, typename = void>
+struct accepts_static_description : std::false_type {};
+
+template <typename Desc>
+struct accepts_static_description<Desc, decltype(static_cast<void>(
+  std::declval<cxxopts::options&>().add_static_options()(
+    "option", std::declval<Desc>())))> : std::true_type {};
+
+template <typename T, typename U, typename = void>
+struct accepts_default : std::false_type {};
+
+template <typename T, typename U>
+struct accepts_default<T, U, decltype(static_cast<void>(
+  cxxopts::value<T>()->default_value(std::declval<U>())))> : std::true_type {};
+
+template <typename T, typename U, typename = void>
+struct accepts_implicit : std::false_type {};
+
+template <typename T, typename U>
+struct accepts_implicit<T, U, decltype(static_cast<void>(
+  cxxopts::value<T>()->implicit_value(std::declval<U>())))> : std::true_type {};
+
 } // namespace
 
 
@@ -65,6 +55,48 @@ TEST_CASE("Value", "traits") {
   CHECK(cxxopts::value<std::vector<std::string>>()->is_container());
 }
 
+TEST_CASE("Value held by the user", "traits") {
+  const auto value = cxxopts::value<std::vector<int>>()
+    ->default_value("1,2")->implicit_value("3");
+
+  value->parse("4,5");
+  CHECK((value->get() == std::vector<int>{4, 5}));
+  value->parse_implicit();
+  CHECK((value->get() == std::vector<int>{4, 5, 3}));
+  value->parse_default();
+  CHECK((value->get() == std::vector<int>{4, 5, 3, 1, 2}));
+  value->reset();
+  CHECK(value->try_parse("6"));
+  CHECK_FALSE(value->try_parse("7,x"));
+  CHECK((value->get() == std::vector<int>{6}));
+  CHECK_FALSE(value->is_bound());
+}
+
+TEST_CASE("Values parsed from part of a text", "traits") {
+  const std::string text = "a,b,1;2;3,t";
+  const cxxopts::string_view view(text);
+
+  const auto tags = cxxopts::value<std::vector<std::string>>();
+  tags->parse(view.substr(0, 3));
+  CHECK((tags->get() == std::vector<std::string>{"a", "b"}));
+
+  const auto numbers = cxxopts::value<std::vector<int>>()->delimiter(';');
+  numbers->parse(view.substr(4, 5));
+  CHECK((numbers->get() == std::vector<int>{1, 2, 3}));
+
+  const auto flag = cxxopts::value<bool>();
+  flag->parse(view.substr(10));
+  CHECK(flag->get());
+
+  const auto letter = cxxopts::value<char>();
+  letter->parse(view.substr(0, 1));
+  CHECK(letter->get() == 'a');
+  CHECK_THROWS_AS(letter->parse(view.substr(0, 2)),
+    cxxopts::argument_incorrect_type&);
+  CHECK_THROWS_AS(flag->parse(view.substr(0, 1)),
+    cxxopts::argument_incorrect_type&);
+}
+
 
 TEST_CASE("Booleans", "[boolean]") {
   cxxopts::options options("booleans", "parses booleans");
@@ -271,6 +303,81 @@ TEST_CASE("Invalid integers", "[integer]") {
 }
 
 
+TEST_CASE("Long integers", "[integer]") {
+  using namespace cxxopts::detail;
+
+  uint64_t u64;
+  int64_t i64;
+
+  // Cover each split of a number into blocks of eight digits.
+  uint64_t expected = 0;
+  std::string text;
+  for (int i = 0; i != 19; ++i) {
+    const auto digit = static_cast<uint64_t>((i * 7 + 3) % 10);
+    expected = expected * 10 + digit;
+    text += static_cast<char>('0' + digit);
+
+    parse_value(text, u64);
+    CHECK(u64 == expected);
+  }
+
+  parse_value("18446744073709551615", u64);
+  CHECK(u64 == std::numeric_limits<uint64_t>::max());
+  parse_value("000000000000000000000042", u64);
+  CHECK(u64 == 42);
+  parse_value("-9223372036854775808", i64);
+  CHECK(i64 == std::numeric_limits<int64_t>::min());
+
+  CHECK_THROWS_AS((parse_value("18446744073709551616", u64)), cxxopts::argument_incorrect_type&);
+  CHECK_THROWS_AS((parse_value("100000000000000000000", u64)), cxxopts::argument_incorrect_type&);
+  CHECK_THROWS_AS((parse_value("1234567a", u64)), cxxopts::argument_incorrect_type&);
+  CHECK_THROWS_AS((parse_value("12345678/", u64)), cxxopts::argument_incorrect_type&);
+  CHECK_THROWS_AS((parse_value("1234:5678", u64)), cxxopts::argument_incorrect_type&);
+}
+
+TEST_CASE("Integer notations", "[integer]") {
+  cxxopts::options options("notations", "parses integer notations");
+  options.add_options()
+    ("d,default", "Default notations", cxxopts::value<std::vector<int>>())
+    ("a,all", "All notations", cxxopts::value<std::vector<int>>()
+      ->integer_notation(cxxopts::notation::hex | cxxopts::notation::binary |
+                         cxxopts::notation::octal)
+      ->digit_separator('\''))
+    ("decimal", "Decimal only", cxxopts::value<int>()
+      ->integer_notation(cxxopts::notation::decimal))
+    ;
+
+  SECTION("Default") {
+    const Argv argv({"notations", "-d", "0XfF,010,-0x10"});
+    const auto result = options.parse(argv.argc(), argv.argv());
+
+    CHECK((result["default"].as<std::vector<int>>() ==
+      std::vector<int>{255, 10, -16}));
+  }
+
+  SECTION("All") {
+    const Argv argv({"notations", "-a", "0b101,0B11,017,0,0x7f'ff,1'000'000"});
+    const auto result = options.parse(argv.argc(), argv.argv());
+
+    CHECK((result["all"].as<std::vector<int>>() ==
+      std::vector<int>{5, 3, 15, 0, 0x7fff, 1000000}));
+  }
+
+  SECTION("Invalid") {
+    for (const auto* arg : {"08", "0b102", "1''0", "'10", "10'", "0x'f"}) {
+      const Argv argv({"notations", "-a", arg});
+      CHECK_THROWS_AS(options.parse(argv.argc(), argv.argv()),
+        cxxopts::argument_incorrect_type&);
+    }
+    const Argv d({"notations", "-d", "1'0"});
+    CHECK_THROWS_AS(options.parse(d.argc(), d.argv()),
+      cxxopts::argument_incorrect_type&);
+    const Argv h({"notations", "--decimal", "0x10"});
+    CHECK_THROWS_AS(options.parse(h.argc(), h.argv()),
+      cxxopts::argument_incorrect_type&);
+  }
+}
+
 TEST_CASE("Floats", "[float]") {
   cxxopts::options options("parses_floats", "parses floats correctly");
   options.add_options()
@@ -302,6 +409,86 @@ TEST_CASE("Floats", "[float]") {
 }
 
 
+TEST_CASE("Float syntax", "[float]") {
+  using namespace cxxopts::detail;
+
+  double d;
+  float f;
+
+  CHECK(validate_value_parser<double>(".5", 0.5));
+  CHECK(validate_value_parser<double>("5.", 5.0));
+  CHECK(validate_value_parser<double>("+1.25E+2", 125.0));
+  CHECK(validate_value_parser<double>("-0.001", -0.001));
+  CHECK(validate_value_parser<double>("1e-5", 1e-5));
+  CHECK(validate_value_parser<double>("123456789012345678901234567890",
+    123456789012345678901234567890.0));
+  CHECK(validate_value_parser<double>("3.14159265358979323846264338327950288",
+    3.14159265358979323846264338327950288));
+  CHECK(validate_value_parser<double>("2.2250738585072014e-308",
+    2.2250738585072014e-308));
+  CHECK(validate_value_parser<float>("0.1", 0.1f));
+  CHECK(validate_value_parser<float>("16777217", 16777216.0f));
+
+  parse_value("INFINITY", d);
+  CHECK(std::isinf(d));
+  parse_value("-nan", f);
+  CHECK(std::isnan(f));
+
+  for (const auto* text : {"", "+", ".", "e5", "1e", "1e+", "1.5abc", "1,5",
+      " 1", "1 ", "0x10", "infx", "1e400", "--1"}) {
+    INFO(text);
+    CHECK_THROWS_AS(parse_value(text, d), cxxopts::argument_incorrect_type&);
+  }
+}
+
+TEST_CASE("Float round trip", "[float]") {
+  using namespace cxxopts::detail;
+
+  char buffer[64];
+  double expected = 1.0;
+  for (int i = 0; i != 2000; ++i) {
+    // Spread values over a wide range of magnitudes.
+    expected = expected * -1.37 + (i % 7) * 1e-3;
+    if (std::fabs(expected) > 1e300) {
+      expected = 1e-300 * (i + 1);
+    }
+    snprintf(buffer, sizeof(buffer), "%.17g", expected);
+
+    double d;
+    parse_value(buffer, d);
+    INFO(buffer);
+    CHECK(d == expected);
+
+    snprintf(buffer, sizeof(buffer), "%.9g", static_cast<float>(i) / 7.0f);
+
+    float f;
+    parse_value(buffer, f);
+    INFO(buffer);
+    CHECK(f == static_cast<float>(i) / 7.0f);
+  }
+}
+
+TEST_CASE("Floats in other locales", "[float]") {
+  const char* locales[] = {"de_DE.UTF-8", "de_DE", "ru_RU.UTF-8", "fr_FR"};
+  bool found = false;
+  for (const auto* name : locales) {
+    if (std::setlocale(LC_ALL, name) != nullptr) {
+      found = true;
+      break;
+    }
+  }
+  if (!found) {
+    return;
+  }
+
+  double d = 0;
+  CHECK_NOTHROW(cxxopts::detail::parse_value("0.5", d));
+  CHECK(d == 0.5);
+  CHECK(validate_value_parser<double>("1.5e300", 1.5e300));
+
+  std::setlocale(LC_ALL, "C");
+}
+
 TEST_CASE("Empty arguments", "[options]") {
   cxxopts::options options("test", " - test empty arguments");
   options.add_options()
@@ -408,6 +595,320 @@ TEST_CASE("Return parse result", "[parse result]") {
   CHECK(result["a"].as<std::string>() == "value");
 }
 
+TEST_CASE("Values outlive arguments", "[options]") {
+  cxxopts::options options("values", " - test values outlive arguments");
+  options.add_options()
+    ("k,key", "a key", cxxopts::value<std::string>())
+    ("l,list", "a list", cxxopts::value<std::vector<std::string>>());
+
+  cxxopts::parse_result result;
+  {
+    const Argv argv({"values", "--key=a=b", "-lx,y", "--list", "z"});
+    result = options.parse(argv.argc(), argv.argv());
+  }
+
+  CHECK(result["key"].as<std::string>() == "a=b");
+  CHECK((result["list"].as<std::vector<std::string>>() ==
+    std::vector<std::string>{"x", "y", "z"}));
+  REQUIRE(result.arguments().size() == 3);
+  CHECK(result.arguments()[0].value() == "a=b");
+}
+
+TEST_CASE("Independent parse results", "[parse result]") {
+  cxxopts::options options("independent", " - test independent results");
+  options.add_options()
+    ("n,number", "a number", cxxopts::value<int>())
+    ("l,list", "a list", cxxopts::value<std::vector<int>>()
+      ->default_value("1,2"));
+  options.compile();
+
+  const Argv first({"independent", "-n", "1", "-l", "5"});
+  const Argv second({"independent", "-n", "2"});
+  const auto r1 = options.parse(first.argc(), first.argv());
+  const auto r2 = options.parse(second.argc(), second.argv());
+  const auto r3 = options.parse(second.argc(), second.argv());
+
+  CHECK(r1["number"].as<int>() == 1);
+  CHECK(r2["number"].as<int>() == 2);
+  CHECK((r1["list"].as<std::vector<int>>() == std::vector<int>{5}));
+  CHECK((r2["list"].as<std::vector<int>>() == std::vector<int>{1, 2}));
+  CHECK((r3["list"].as<std::vector<int>>() == std::vector<int>{1, 2}));
+}
+
+TEST_CASE("Reuse parse result", "[parse result]") {
+  cxxopts::options options("reuse", " - test reuse of parse result");
+  options.add_options()
+    ("n,number", "a number", cxxopts::value<int>())
+    ("s,string", "a string", cxxopts::value<std::string>())
+    ("l,list", "a list", cxxopts::value<std::vector<int>>());
+  options.allow_unrecognised_options().compile();
+
+  cxxopts::parse_result result;
+
+  const Argv first({"reuse", "-n", "1", "-l", "1,2,3,4", "-s", "x", "--y"});
+  options.parse(first.argc(), first.argv(), result);
+
+  REQUIRE(result.count("list") == 1);
+  const auto* data = result["list"].as<std::vector<int>>().data();
+  CHECK(result["string"].as<std::string>() == "x");
+  CHECK(result.unmatched().size() == 1);
+  CHECK(result.arguments().size() == 3);
+
+  const Argv second({"reuse", "-l", "5,6", "-n", "2"});
+  options.parse(second.argc(), second.argv(), result);
+
+  CHECK(result["number"].as<int>() == 2);
+  CHECK(result.count("string") == 0);
+  CHECK_THROWS_AS(result["string"].as<std::string>(),
+    cxxopts::option_has_no_value_error&);
+  CHECK((result["list"].as<std::vector<int>>() == std::vector<int>{5, 6}));
+  CHECK(result["list"].as<std::vector<int>>().data() == data);
+  CHECK(result.unmatched().empty());
+  CHECK(result.arguments().size() == 2);
+  CHECK(result.consumed() == 5);
+
+  SECTION("Copies keep their values") {
+    const auto saved = result;
+    const auto number = result["number"];
+    const Argv third({"reuse", "-n", "3", "-l", "7"});
+    options.parse(third.argc(), third.argv(), result);
+
+    CHECK(result["number"].as<int>() == 3);
+    CHECK((result["list"].as<std::vector<int>>() == std::vector<int>{7}));
+    CHECK(saved["number"].as<int>() == 2);
+    CHECK(number.as<int>() == 2);
+    CHECK((saved["list"].as<std::vector<int>>() == std::vector<int>{5, 6}));
+  }
+
+  SECTION("Other specification") {
+    cxxopts::options other("other", " - another specification");
+    other.add_options()("o,other", "other option");
+
+    const Argv third({"other", "-o"});
+    other.parse(third.argc(), third.argv(), result);
+
+    CHECK(result.count("other") == 1);
+    CHECK(result.count("number") == 0);
+    CHECK_THROWS_AS(result["number"], cxxopts::option_not_present_error&);
+  }
+}
+
+TEST_CASE("Lazy conversion", "[parse result]") {
+  int bound = 0;
+
+  cxxopts::options options("lazy", " - test lazy conversion");
+  options.add_options()
+    ("n,number", "a number", cxxopts::value<int>())
+    ("b,bound", "a bound number", cxxopts::value<int>(bound))
+    ("l,list", "a list", cxxopts::value<std::vector<int>>())
+    ("d,default", "a default", cxxopts::value<std::vector<int>>()
+      ->default_value("7,8"));
+  options.lazy_conversion().compile();
+
+  const Argv argv({"lazy", "-n", "x", "-b", "3", "-l", "1,2", "--list=3"});
+  cxxopts::parse_result result;
+  CHECK_NOTHROW(options.parse(argv.argc(), argv.argv(), result));
+
+  CHECK(bound == 3);
+  CHECK(result.count("number") == 1);
+  CHECK(result.count("list") == 2);
+  CHECK_THROWS_AS(result["number"].as<int>(), cxxopts::argument_incorrect_type&);
+  CHECK_THROWS_AS(result["number"].as<int>(), cxxopts::argument_incorrect_type&);
+  CHECK((result["list"].as<std::vector<int>>() == std::vector<int>{1, 2, 3}));
+  CHECK((result["list"].as<std::vector<int>>() == std::vector<int>{1, 2, 3}));
+  CHECK((result["default"].as<std::vector<int>>() == std::vector<int>{7, 8}));
+
+  const Argv again({"lazy", "-n", "5", "-l", "4"});
+  options.parse(again.argc(), again.argv(), result);
+
+  CHECK(result["number"].as<int>() == 5);
+  CHECK((result["list"].as<std::vector<int>>() == std::vector<int>{4}));
+  CHECK((result["default"].as<std::vector<int>>() == std::vector<int>{7, 8}));
+}
+
+TEST_CASE("Lazy conversion of copies", "[parse result]") {
+  cxxopts::options options("lazy", " - test lazy conversion");
+  options.add_options()
+    ("l,list", "a list", cxxopts::value<std::vector<int>>());
+  options.lazy_conversion();
+
+  const Argv argv({"lazy", "-l", "1,2", "--list=3"});
+
+  // Copies of deferred values keep the texts after the result is
+  // parsed again.
+  auto reused = options.parse(argv.argc(), argv.argv());
+  const auto value = reused["list"];
+  const Argv again({"lazy", "-l", "4"});
+  options.parse(again.argc(), again.argv(), reused);
+
+  CHECK((value.as<std::vector<int>>() == std::vector<int>{1, 2, 3}));
+  CHECK((reused["list"].as<std::vector<int>>() == std::vector<int>{4}));
+}
+
+TEST_CASE("Arguments in order of appearance", "[parse result]") {
+  cxxopts::options options("arguments", " - test list of arguments");
+  options.add_options()
+    ("f,flag", "a flag")
+    ("o,output", "an output", cxxopts::value<std::string>()
+      ->implicit_value("a.out"))
+    ("i,input", "inputs", cxxopts::value<std::vector<std::string>>());
+  options.parse_positional("input");
+
+  const Argv argv({"arguments", "x", "-fo", "--input=y", "--output", "z"});
+  const auto result = options.parse(argv.argc(), argv.argv());
+
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+  for (const auto& kv : result.arguments()) {
+    keys.push_back(kv.key());
+    values.push_back(kv.value());
+  }
+
+  CHECK((keys == std::vector<std::string>{
+    "input", "flag", "output", "input", "output"}));
+  CHECK((values == std::vector<std::string>{"x", "true", "a.out", "y", "z"}));
+  CHECK(result.arguments()[2].as<std::string>() == "a.out");
+  CHECK(result.arguments()[3].value_view() == "y");
+
+  const std::vector<cxxopts::parse_result::key_value> copy = result.arguments();
+  REQUIRE(copy.size() == 5);
+  CHECK(copy[4].key() == "output");
+
+}
+
+#if defined(__GNUC__)
+# pragma GCC diagnostic push
+# pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+
+TEST_CASE("Deprecated hashes of options", "[parse result]") {
+  cxxopts::options options("hashed", " - test deprecated constructor");
+  options.add_options()
+    ("n,number", "a number", cxxopts::value<int>());
+
+  const Argv argv({"hashed", "-n", "3", "extra"});
+  options.allow_unrecognised_options();
+  auto parsed = options.parse(argv.argc(), argv.argv());
+
+  const std::string name = "number";
+  cxxopts::parse_result::name_hash_map keys{{"n", 7}, {"number", 7}};
+  cxxopts::parse_result::parsed_hash_map values;
+  values.emplace(7, parsed["number"]);
+  std::vector<cxxopts::parse_result::key_value> sequential{{name, "3"}};
+
+  const cxxopts::parse_result result(std::move(keys), std::move(values),
+    std::move(sequential), {"extra"}, 4);
+
+  CHECK(result.count("n") == 1);
+  CHECK(result["number"].as<int>() == 3);
+  CHECK(result.count("other") == 0);
+  REQUIRE(result.arguments().size() == 1);
+  CHECK(result.arguments()[0].key() == "number");
+  CHECK(result.arguments()[0].value() == "3");
+  CHECK((result.unmatched() == std::vector<std::string>{"extra"}));
+  CHECK(result.consumed() == 4);
+
+  const auto group = options.group_help("");
+  REQUIRE(group.options.size() == 1);
+  CHECK(group.options[0]->hash() ==
+    std::hash<std::string>{}(std::string("number") + "n"));
+}
+
+#if defined(__GNUC__)
+# pragma GCC diagnostic pop
+#endif
+
+TEST_CASE("Parse without exceptions", "[parse result]") {
+  cxxopts::options options("try_parse", " - test parsing without exceptions");
+  options.add_options()
+    ("i,int", "an integer", cxxopts::value<int>())
+    ("l,list", "a list", cxxopts::value<std::vector<int>>())
+    ("s,string", "a string", cxxopts::value<std::string>())
+    ("f,flag", "a flag")
+    ;
+
+  SECTION("Valid arguments") {
+    const Argv argv({"try_parse", "-i", "5", "--list=1,2", "-f"});
+    const auto outcome = options.try_parse(argv.argc(), argv.argv());
+
+    REQUIRE(outcome);
+    CHECK(outcome.errors().empty());
+    CHECK(outcome.result()["int"].as<int>() == 5);
+    CHECK(outcome.result().count("flag") == 1);
+  }
+
+  SECTION("First error") {
+    const Argv argv({"try_parse", "-f", "--unknown", "-i", "x"});
+    const auto outcome = options.try_parse(argv.argc(), argv.argv());
+
+    REQUIRE_FALSE(outcome.ok());
+    REQUIRE(outcome.errors().size() == 1);
+
+    const auto& error = outcome.errors()[0];
+    CHECK(error.code() == cxxopts::parse_error_code::option_not_exists);
+    CHECK(error.index() == 2);
+    CHECK(error.argument() == "unknown");
+    CHECK(error.message() ==
+      cxxopts::option_not_exists_error("unknown").what());
+  }
+
+  SECTION("All errors") {
+    const Argv argv({"try_parse", "-i", "x", "--list", "1,a", "-z",
+      "-f", "---", "-s"});
+    const auto outcome = options.try_parse(argv.argc(), argv.argv(), true);
+
+    REQUIRE(outcome.errors().size() == 5);
+
+    const auto& errors = outcome.errors();
+    CHECK(errors[0].code() == cxxopts::parse_error_code::incorrect_argument);
+    CHECK(errors[0].index() == 2);
+    CHECK(errors[0].argument() == "x");
+    CHECK(errors[0].option() == "int");
+    CHECK(errors[1].code() == cxxopts::parse_error_code::incorrect_argument);
+    CHECK(errors[1].index() == 4);
+    CHECK(errors[1].option() == "list");
+    CHECK(errors[2].code() == cxxopts::parse_error_code::option_not_exists);
+    CHECK(errors[2].index() == 5);
+    CHECK(errors[3].code() == cxxopts::parse_error_code::option_syntax);
+    CHECK(errors[3].index() == 7);
+    CHECK(errors[4].code() == cxxopts::parse_error_code::missing_argument);
+    CHECK(errors[4].index() == 8);
+    CHECK(outcome.result().count("flag") == 1);
+  }
+
+  SECTION("Failed values are left unchanged") {
+    std::vector<int> bound{7};
+    options.add_options()
+      ("b,bound", "a bound list", cxxopts::value(bound))
+      ("n,nested", "a nested list",
+        cxxopts::value<std::vector<std::vector<int>>>());
+
+    const Argv argv({"try_parse", "-b", "1,2", "-b", "3,x", "-l", "4",
+      "-l", "5,6,y", "-n", "8,9", "-n", "0,z"});
+    const auto outcome = options.try_parse(argv.argc(), argv.argv(), true);
+
+    REQUIRE(outcome.errors().size() == 3);
+    CHECK((bound == std::vector<int>{7, 1, 2}));
+    CHECK(outcome.result().count("list") == 1);
+    CHECK((outcome.result()["list"].as<std::vector<int>>() ==
+      std::vector<int>{4}));
+    CHECK((outcome.result()["nested"].as<std::vector<std::vector<int>>>() ==
+      std::vector<std::vector<int>>{{8, 9}}));
+  }
+
+  SECTION("Deferred values") {
+    options.lazy_conversion();
+
+    const Argv argv({"try_parse", "-i", "x", "--list", "1,2"});
+    const auto outcome = options.try_parse(argv.argc(), argv.argv(), true);
+
+    REQUIRE(outcome.errors().size() == 1);
+    CHECK(outcome.errors()[0].option() == "int");
+    CHECK((outcome.result()["list"].as<std::vector<int>>() ==
+      std::vector<int>{1, 2}));
+  }
+}
+
 TEST_CASE("Subcommand options", "[options]") {
   const Argv argv({"test_subcommand", "-a", "value", "subcmd", "-a", "-x"});
 
@@ -452,6 +953,29 @@ TEST_CASE("Short options", "[options]") {
     cxxopts::invalid_option_format_error&);
 }
 
+TEST_CASE("Clustered short options", "[options]") {
+  cxxopts::options options("test_short", " - test clustered short options");
+  options.add_options()
+    ("x", "extract")
+    ("v,verbose", "verbose")
+    ("z", "compress")
+    ("f,file", "a file", cxxopts::value<std::string>());
+  options.compile();
+
+  const Argv argv({"test_short", "-xvzf", "a.tar", "-vv", "-f", "-y"});
+  const auto result = options.parse(argv.argc(), argv.argv());
+
+  CHECK(result.count("x") == 1);
+  CHECK(result.count("verbose") == 3);
+  CHECK(result.count("z") == 1);
+  CHECK(result.count("file") == 2);
+  CHECK(result["file"].as<std::string>() == "-y");
+
+  const Argv unknown({"test_short", "-xq"});
+  CHECK_THROWS_AS(options.parse(unknown.argc(), unknown.argv()),
+    cxxopts::option_not_exists_error&);
+}
+
 TEST_CASE("Short options without space", "[options]") {
   cxxopts::options options("test_short", " - test short options without space");
 
@@ -467,6 +991,155 @@ TEST_CASE("Short options without space", "[options]") {
   CHECK(result["a"].as<std::string>() == "value");
 }
 
+TEST_CASE("Compiled options", "[options]") {
+  cxxopts::options options("compiled", " - test compiled options");
+  options.add_options()
+    ("a,alpha", "a short and long option", cxxopts::value<std::string>())
+    ("b", "a short option")
+    ("gamma", "a long option", cxxopts::value<int>()->default_value("3"))
+    ;
+  options.compile();
+
+  const Argv argv({"compiled", "--alpha", "x", "-b", "--gamma=7"});
+  auto result = options.parse(argv.argc(), argv.argv());
+
+  CHECK(result["alpha"].as<std::string>() == "x");
+  CHECK(result["a"].as<std::string>() == "x");
+  CHECK(result.count("b") == 1);
+  CHECK(result["gamma"].as<int>() == 7);
+
+  SECTION("Unknown option") {
+    const Argv av({"compiled", "--delta"});
+    CHECK_THROWS_AS(options.parse(av.argc(), av.argv()),
+      cxxopts::option_not_exists_error&);
+  }
+
+  SECTION("Options defined after compile") {
+    options.add_options()("delta", "a new option");
+
+    const Argv av({"compiled", "--delta", "-b"});
+    result = options.parse(av.argc(), av.argv());
+
+    CHECK(result.count("delta") == 1);
+    CHECK(result.count("b") == 1);
+  }
+}
+
+TEST_CASE("Lookup table built by parse", "[options]") {
+  cxxopts::options options("lazy_index", " - lookup table without compile");
+  options.add_options()
+    ("a,alpha", "a short and long option", cxxopts::value<std::string>())
+    ("b", "a short option");
+
+  const auto before = options.memory_usage().lookup;
+  const Argv argv({"lazy_index", "--alpha", "x", "-b"});
+  cxxopts::parse_result result;
+  options.parse(argv.argc(), argv.argv(), result);
+  const auto built = options.memory_usage().lookup;
+  CHECK(built > before);
+
+  // The table is kept for later calls.
+  options.parse(argv.argc(), argv.argv(), result);
+  CHECK(options.memory_usage().lookup == built);
+  CHECK(result["alpha"].as<std::string>() == "x");
+
+  // Adding an option discards the table.
+  options.add_options()("delta", "a new option");
+  CHECK(options.memory_usage().lookup < built);
+
+  const Argv av({"lazy_index", "--delta", "-b"});
+  options.parse(av.argc(), av.argv(), result);
+  CHECK(result.count("delta") == 1);
+  CHECK(result.count("b") == 1);
+}
+
+TEST_CASE("Options with similar names", "[options]") {
+  cxxopts::options options("similar", " - test options with similar names");
+  options.add_options()
+    ("abc", "a long option", cxxopts::value<std::string>())
+    ("c,ab", "a short and long option", cxxopts::value<std::string>())
+    ;
+
+  const Argv argv({"similar", "--abc", "x", "-c", "y"});
+  auto result = options.parse(argv.argc(), argv.argv());
+
+  CHECK(result.count("abc") == 1);
+  CHECK(result.count("ab") == 1);
+  CHECK(result["abc"].as<std::string>() == "x");
+  CHECK(result["ab"].as<std::string>() == "y");
+  CHECK(result["c"].as<std::string>() == "y");
+}
+
+TEST_CASE("Option handles", "[options]") {
+  cxxopts::options options("handles", " - test option handles");
+  const auto verbose = options.add_option("", "v,verbose", "verbose output");
+  const auto level = options.add_option("", "l,level", "a level",
+    cxxopts::value<int>()->default_value("1"));
+  const auto names = options.add_option("Group", "name", "a list of names",
+    cxxopts::value<std::vector<std::string>>());
+  options.compile();
+
+  const Argv argv({"handles", "-v", "--level", "5", "--name", "a",
+    "--name", "b"});
+  const auto result = options.parse(argv.argc(), argv.argv());
+
+  CHECK(result.count(verbose) == 1);
+  CHECK(result.get(verbose));
+  CHECK(result.get(level) == 5);
+  CHECK((result.get(names) == std::vector<std::string>{"a", "b"}));
+  CHECK(&result.get(level) == &result["level"].as<int>());
+
+  SECTION("Default values") {
+    const Argv av({"handles"});
+    const auto defaults = options.parse(av.argc(), av.argv());
+
+    CHECK_FALSE(defaults.has(verbose));
+    CHECK(defaults.get(level) == 1);
+    CHECK_THROWS_AS(defaults.get(names), cxxopts::option_has_no_value_error&);
+  }
+
+  SECTION("Lazy conversion") {
+    options.lazy_conversion();
+
+    const Argv av({"handles", "-l", "x"});
+    const auto lazy = options.parse(av.argc(), av.argv());
+
+    CHECK(lazy.count(level) == 1);
+    CHECK_THROWS_AS(lazy.get(level), cxxopts::argument_incorrect_type&);
+  }
+  SECTION("Handles are made only by the specification") {
+    static_assert(!std::is_constructible<cxxopts::option_handle<int>,
+      const cxxopts::option_details&>::value,
+      "a handle can be made for an option of another type");
+  }
+
+  SECTION("Handles of other specifications") {
+    cxxopts::options other("other", " - test foreign handles");
+    const auto number = other.add_option("", "n,number", "a number",
+      cxxopts::value<int>()->default_value("3"));
+    const auto extra = other.add_option("", "extra", "not in the first");
+    other.add_option("", "third", "a third option");
+
+    CHECK_THROWS_AS(result.get(number), cxxopts::option_not_present_error&);
+    CHECK_THROWS_AS(static_cast<void>(result.count(number)),
+      cxxopts::option_not_present_error&);
+    CHECK_THROWS_AS(static_cast<void>(result.has(extra)),
+      cxxopts::option_not_present_error&);
+
+    const cxxopts::parse_result empty;
+    CHECK_THROWS_AS(empty.get(level), cxxopts::option_not_present_error&);
+
+    const Argv av({"other"});
+    const auto foreign = other.parse(av.argc(), av.argv());
+    CHECK(foreign.get(number) == 3);
+    CHECK_THROWS_AS(foreign.get(names), cxxopts::option_not_present_error&);
+
+    // Copies of a specification share the options.
+    const auto copy = options;
+    CHECK(copy.parse(av.argc(), av.argv()).get(level) == 1);
+  }
+}
+
 TEST_CASE("No positional", "[positional]") {
   cxxopts::options options("test", " - test no positional options");
 
@@ -768,6 +1441,83 @@ TEST_CASE("Default values", "[default]") {
   }
 }
 
+TEST_CASE("Typed default values", "[default]") {
+  static_assert(accepts_default<std::string, const char*>::value,
+    "text is rejected as a default");
+  static_assert(!accepts_default<std::string, std::nullptr_t>::value,
+    "nullptr is accepted as a default");
+  static_assert(!accepts_implicit<std::string, std::nullptr_t>::value,
+    "nullptr is accepted as an implicit value");
+  static_assert(!accepts_default<int, std::nullptr_t>::value,
+    "nullptr is accepted as a default");
+
+  cxxopts::options options("defaults", "has typed defaults");
+  options.add_options()
+    ("n,number", "A number", cxxopts::value<int>()
+      ->default_value(42)->implicit_value(7))
+    ("r,ratio", "A ratio", cxxopts::value<double>()->default_value(0.5))
+    ("v,vector", "Default vector", cxxopts::value<std::vector<int>>()
+      ->default_value({1, 4}))
+    ;
+
+  SECTION("Sets defaults") {
+    const Argv argv({"defaults"});
+    const auto result = options.parse(argv.argc(), argv.argv());
+
+    CHECK(result.count("number") == 0);
+    CHECK(result["number"].as<int>() == 42);
+    CHECK(result["ratio"].as<double>() == 0.5);
+    CHECK((result["vector"].as<std::vector<int>>() == std::vector<int>{1, 4}));
+  }
+
+  SECTION("Sets implicit value") {
+    const Argv argv({"defaults", "-n", "-v", "5"});
+    const auto result = options.parse(argv.argc(), argv.argv());
+
+    CHECK(result.count("number") == 1);
+    CHECK(result["number"].as<int>() == 7);
+    CHECK((result["vector"].as<std::vector<int>>() == std::vector<int>{5}));
+  }
+
+  SECTION("Shows defaults in help") {
+    const auto help = options.help();
+
+    CHECK(help.find("(default: 42)") != std::string::npos);
+    CHECK(help.find("(default: 0.5)") != std::string::npos);
+    CHECK(help.find("(default: 1,4)") != std::string::npos);
+  }
+
+  SECTION("Invalid default is reported on definition") {
+    CHECK_THROWS_AS(options.add_options()
+      ("bad", "A bad default", cxxopts::value<int>()->default_value("x")),
+      cxxopts::argument_incorrect_type&);
+  }
+  SECTION("Settings of the parser after a typed default") {
+    options.add_options()
+      ("l,list", "A list", cxxopts::value<std::vector<int>>()
+        ->default_value(std::vector<int>{1, 4})
+        ->implicit_value(std::vector<int>{2, 3})
+        ->delimiter(';'))
+      ("p,precise", "A precise ratio", cxxopts::value<double>()
+        ->default_value(0.123456789)->integer_notation(0));
+
+    const Argv argv({"defaults", "--list=5;6", "--list"});
+    const auto result = options.parse(argv.argc(), argv.argv());
+    CHECK((result["list"].as<std::vector<int>>() ==
+      std::vector<int>{5, 6, 2, 3}));
+    CHECK(result["precise"].as<double>() == 0.123456789);
+
+    const Argv none({"defaults"});
+    const auto defaults = options.parse(none.argc(), none.argv());
+    CHECK((defaults["list"].as<std::vector<int>>() == std::vector<int>{1, 4}));
+
+    const auto help = options.help();
+    CHECK(help.find("[=arg(=2;3)]") != std::string::npos);
+    CHECK(help.find("(default: 1;4)") != std::string::npos);
+    CHECK(help.find("(default: 0.123456789)") != std::string::npos);
+  }
+}
+
 TEST_CASE("Parse into a reference", "[reference]") {
   int value = 0;
   bool b_value = true;
@@ -873,6 +1623,25 @@ TEST_CASE("Unrecognised options", "[options]") {
     auto result = options.parse(argc, argv);
     auto& unmatched = result.unmatched();
     CHECK((unmatched == std::vector<std::string>{"--unknown", "-u", "--another_unknown", "-a"}));
+    CHECK(result.unmatched_arguments().empty());
+  }
+
+  SECTION("Without copies of unmatched arguments") {
+    options.allow_unrecognised_options().view_unmatched();
+    auto result = options.parse(argc, argv);
+    CHECK(result.unmatched().empty());
+
+    const auto& unmatched = result.unmatched_arguments();
+    REQUIRE(unmatched.size() == 4);
+    CHECK(unmatched[0].index() == 1);
+    CHECK(unmatched[0].text().data() == argv[1]);
+    CHECK(!unmatched[0].is_fragment());
+    CHECK(unmatched[1].index() == 3);
+    CHECK(unmatched[1].is_fragment());
+    CHECK(unmatched[1].text() == "u");
+    CHECK(unmatched[1].str() == "-u");
+    CHECK(unmatched[2].str() == "--another_unknown");
+    CHECK(unmatched[3].index() == 5);
   }
 }
 
@@ -1120,6 +1889,122 @@ TEST_CASE("Custom delimiter", "[parser]") {
   CHECK(tests[3] == "x,y,z");
 }
 
+TEST_CASE("Long lists", "[parser]") {
+  cxxopts::options options("parser", " - test long lists");
+  options.add_options()
+    ("ids", "list of ids", cxxopts::value<std::vector<int>>())
+    ("names", "list of names", cxxopts::value<std::vector<std::string>>());
+
+  std::string ids;
+  std::vector<int> expected;
+  for (int i = 0; i != 10000; ++i) {
+    ids += std::to_string(i * 37) + ",";
+    expected.push_back(i * 37);
+  }
+  const Argv argv({"test", "--ids", ids.c_str(), "--ids=1",
+    "--names=a,,bc,", "--names=,"});
+  const auto result = options.parse(argv.argc(), argv.argv());
+
+  expected.push_back(1);
+  CHECK(result["ids"].as<std::vector<int>>() == expected);
+  CHECK((result["names"].as<std::vector<std::string>>() ==
+    std::vector<std::string>{"a", "", "bc", ""}));
+}
+
+template <typename T>
+void check_list_of_numbers() {
+  cxxopts::options options("parser", " - test lists of numbers");
+  options.add_options()
+    ("values", "list of numbers", cxxopts::value<std::vector<T>>());
+
+  // Lengths of the fields vary so that delimiters fall on every
+  // position of a block.
+  std::string text;
+  std::vector<T> expected;
+  for (int i = 0; i != 1000; ++i) {
+    const auto value = static_cast<T>((i % 2 ? -1 : 1) * (i * i % 100003));
+    text += std::to_string(static_cast<int64_t>(value)) + ",";
+    expected.push_back(value);
+  }
+
+  const Argv argv({"test", "--values", text.c_str()});
+  const auto result = options.parse(argv.argc(), argv.argv());
+  CHECK(result["values"].as<std::vector<T>>() == expected);
+
+  std::vector<T> sink;
+  cxxopts::parse_list<T>(text, std::back_inserter(sink));
+  CHECK(sink == expected);
+
+  text.insert(700, "x");
+  const Argv invalid({"test", "--values", text.c_str()});
+  CHECK_THROWS_AS(options.parse(invalid.argc(), invalid.argv()),
+    cxxopts::argument_incorrect_type&);
+}
+
+TEST_CASE("Lists of numbers", "[parser]") {
+  check_list_of_numbers<int32_t>();
+  check_list_of_numbers<int64_t>();
+  check_list_of_numbers<float>();
+  check_list_of_numbers<double>();
+}
+
+TEST_CASE("Parse list into a buffer", "[parser]") {
+  cxxopts::parse_context ctx;
+  ctx.delimiter = ';';
+
+  double buffer[4] = {};
+  const auto end = cxxopts::parse_list<double>("0.5;-2;1e3", buffer, ctx);
+
+  CHECK(end - buffer == 3);
+  CHECK(buffer[0] == 0.5);
+  CHECK(buffer[1] == -2);
+  CHECK(buffer[2] == 1000);
+
+  int ints[2] = {};
+  CHECK_THROWS_AS(cxxopts::parse_list<int>("", ints),
+    cxxopts::argument_incorrect_type&);
+  CHECK((cxxopts::parse_list<int>("1,2,", ints) - ints) == 2);
+}
+
+TEST_CASE("Split delimited text", "[parser]") {
+  const auto split = [](const std::string& text, const char delimiter) {
+    std::vector<std::string> fields;
+    cxxopts::detail::for_each_field(text, delimiter,
+      [&fields](const cxxopts::string_view field) {
+        fields.emplace_back(field.data(), field.size());
+        return true;
+      });
+    return fields;
+  };
+  // Fields as split one character at a time.
+  const auto expected = [](const std::string& text, const char delimiter) {
+    std::vector<std::string> fields(1);
+    for (std::size_t i = 0; i != text.size(); ++i) {
+      if (text[i] != delimiter) {
+        fields.back() += text[i];
+      } else if (i + 1 != text.size()) {
+        fields.emplace_back();
+      }
+    }
+    return fields;
+  };
+
+  std::string text;
+  for (int i = 0; i != 200; ++i) {
+    INFO(text);
+    CHECK(split(text, ',') == expected(text, ','));
+    text += (i % 3 == 0 || i % 7 == 0) ? ',' : static_cast<char>('a' + i % 26);
+  }
+  text.assign(64, '\xAC');
+  CHECK(split(text, ',') == std::vector<std::string>{text});
+  CHECK(split(text, '\xAC').size() == 64);
+
+  std::vector<std::string> strings;
+  cxxopts::value_parser<std::vector<std::string>>().parse(
+    cxxopts::parse_context(), "", strings);
+  CHECK(strings == std::vector<std::string>{""});
+}
+
 TEST_CASE("Vector of vector", "[parser]") {
   cxxopts::options options("parser", " - test vector of vector");
   options.add_options()
@@ -1197,3 +2082,392 @@ TEST_CASE("Long and short options format", "[options]") {
       cxxopts::invalid_option_format_error&);
   }
 }
+
+TEST_CASE("Arena storage", "[options]") {
+  cxxopts::parse_result result;
+  {
+    cxxopts::options options("arena", " - options in an arena");
+    options.use_arena().add_options()
+      ("v,verbose", "Verbose output")
+      ("n,threads", "Number of threads", cxxopts::value<int>()->default_value("1"))
+      ("a-very-long-option-name", "Long name", cxxopts::value<std::string>());
+
+    CHECK_THROWS_AS(options.add_options()("threads", "Duplicate"),
+      cxxopts::option_exists_error&);
+    CHECK_THROWS_AS(options.add_options()("a-very-long-option-name", "Duplicate"),
+      cxxopts::option_exists_error&);
+
+    auto copy = options;
+    copy.add_options()("extra", "Option of the copy");
+
+    Argv av({"arena", "-v", "--a-very-long-option-name", "text"});
+    result = options.parse(av.argc(), av.argv());
+
+    Argv extra({"arena", "--extra"});
+    CHECK(copy.parse(extra.argc(), extra.argv()).count("extra") == 1);
+    CHECK_THROWS_AS(options.parse(extra.argc(), extra.argv()),
+      cxxopts::option_not_exists_error&);
+  }
+
+  // Details of options are kept alive by the result.
+  CHECK(result.count("verbose") == 1);
+  CHECK(result["threads"].as<int>() == 1);
+  CHECK(result["a-very-long-option-name"].as<std::string>() == "text");
+}
+
+TEST_CASE("Texts in the arena", "[options]") {
+  const std::string description =
+    "A description which is long enough to be allocated";
+  const std::string arg_help = "A-LONG-ARGUMENT-NAME-OF-THE-OPTION";
+
+  cxxopts::options copy("copy");
+  {
+    cxxopts::options options("arena", " - texts in an arena");
+    options.use_arena().add_options()
+      ("o,output", description, cxxopts::value<std::string>(), arg_help);
+    CHECK(options.memory_usage().descriptions == 0);
+
+    const auto group = options.group_help("");
+    REQUIRE(group.options.size() == 1);
+    const auto view = group.options[0]->description_view();
+    CHECK(std::string(view.data(), view.size()) == description);
+    CHECK(view.data() != description.data());
+    CHECK(group.options[0]->arg_help() == arg_help);
+
+    copy = options;
+  }
+
+  // Copies share details of the options and their texts.
+  const auto help = copy.help();
+  CHECK(help.find("long enough") != std::string::npos);
+  CHECK(help.find(arg_help) != std::string::npos);
+}
+
+TEST_CASE("Memory usage", "[options]") {
+  cxxopts::options options("usage", " - memory of a specification");
+  const auto empty = options.memory_usage();
+
+  options.add_options()
+    ("v,verbose", "Verbose output")
+    ("a-very-long-option-name", "A description which does not fit inline",
+      cxxopts::value<std::string>(), "A-LONG-ARGUMENT-NAME");
+  options.add_options("Group")
+    ("n,threads", "Threads", cxxopts::value<int>());
+
+  const auto report = options.memory_usage();
+  CHECK(report.options > empty.options);
+  CHECK(report.names != 0);
+  CHECK(report.descriptions != 0);
+  CHECK(report.lookup > empty.lookup);
+  CHECK(report.help > empty.help);
+  CHECK(report.total() == report.options + report.names +
+    report.descriptions + report.lookup + report.help);
+
+  options.compile();
+  CHECK(options.memory_usage().lookup > report.lookup);
+
+  const auto group = options.group_help("Group");
+  CHECK(group.name == "Group");
+  REQUIRE(group.options.size() == 1);
+  CHECK(group.options[0]->long_name() == "threads");
+  CHECK(options.group_help("").options.size() == 2);
+  CHECK_THROWS_AS(options.group_help("Missing"), std::out_of_range&);
+
+  for (int i = 0; i != 100; ++i) {
+    options.add_options()("option-" + std::to_string(i), "Option");
+  }
+  CHECK_THROWS_AS(options.add_options()("option-42", "Duplicate"),
+    cxxopts::option_exists_error&);
+  CHECK_THROWS_AS(options.add_options()("n,other", "Duplicate"),
+    cxxopts::option_exists_error&);
+}
+
+TEST_CASE("Static descriptions", "[options]") {
+  static_assert(accepts_static_description<const char (&)[4]>::value,
+    "literals are rejected as static descriptions");
+  static_assert(!accepts_static_description<std::string>::value,
+    "temporary strings are accepted as static descriptions");
+  static_assert(!accepts_static_description<const char*>::value,
+    "pointers are accepted as static descriptions");
+
+  static const char description[] =
+    "A description which is long enough to be allocated when copied";
+
+  cxxopts::options options("static", " - descriptions kept by reference");
+  options.add_static_options()
+    ("v,verbose", description)
+    ("o,output", "Output file", cxxopts::value<std::string>(), "FILE");
+  options.add_static_options("Group")
+    ("n,threads", "Number of threads", cxxopts::value<int>());
+
+  const auto group = options.group_help("");
+  REQUIRE(group.options.size() == 2);
+  CHECK(group.options[0]->description_view().data() == description);
+  CHECK(group.options[1]->arg_help_view() == "FILE");
+
+  const std::string arg_help = group.options[1]->arg_help();
+  const cxxopts::cxx_string desc = group.options[1]->description();
+  CHECK(arg_help == "FILE");
+  CHECK((desc == cxxopts::make_local_string("Output file")));
+  CHECK(options.memory_usage().descriptions == 0);
+
+  const auto help = options.help();
+  CHECK(help.find("A description which is long") != std::string::npos);
+  CHECK(help.find("-o, --output FILE") != std::string::npos);
+  CHECK(help.find("Number of threads") != std::string::npos);
+
+  CHECK_THROWS_AS(options.add_static_options()("o,other", "Duplicate"),
+    cxxopts::option_exists_error&);
+  CHECK_THROWS_AS(options.add_static_options()("flag,f", "Bad"),
+    cxxopts::invalid_option_format_error&);
+
+  Argv av({"static", "-v", "--output", "file", "-n", "2"});
+  const auto result = options.parse(av.argc(), av.argv());
+  CHECK(result.count("verbose") == 1);
+  CHECK(result["output"].as<std::string>() == "file");
+  CHECK(result["threads"].as<int>() == 2);
+}
+
+#ifdef CXXOPTS_HAS_MEMORY_RESOURCE
+namespace {
+
+class counting_resource : public std::pmr::memory_resource {
+public:
+  explicit counting_resource(std::pmr::memory_resource* upstream)
+    : upstream_(upstream) {
+  }
+
+  counting_resource(const counting_resource&) = delete;
+  counting_resource& operator=(const counting_resource&) = delete;
+
+  std::size_t allocations = 0;
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t align) override {
+    ++allocations;
+    return upstream_->allocate(bytes, align);
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+    upstream_->deallocate(p, bytes, align);
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  std::pmr::memory_resource* upstream_;
+};
+
+} // namespace
+
+TEST_CASE("Memory resource", "[options]") {
+  cxxopts::options options("resource", " - results in a memory resource");
+  options.add_options()
+    ("v,verbose", "Verbose output")
+    ("n,threads", "Number of threads", cxxopts::value<int>()->default_value("1"))
+    ("i,input", "Input files", cxxopts::value<std::vector<std::string>>())
+    ("a-very-long-option-name", "Long name", cxxopts::value<std::string>());
+  options.compile();
+
+  Argv av({"resource", "-v", "--input", "a", "-i", "b",
+    "--a-very-long-option-name", "a text which does not fit inline"});
+
+  std::array<std::byte, 16384> buffer;
+  std::pmr::monotonic_buffer_resource arena(
+    buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+  counting_resource resource(&arena);
+
+  auto result = options.parse(av.argc(), av.argv(), &resource);
+  CHECK(result.get_allocator().resource() == &resource);
+  CHECK(resource.allocations != 0);
+  CHECK(result.count("verbose") == 1);
+  CHECK(result["threads"].as<int>() == 1);
+  CHECK(result["input"].as<std::vector<std::string>>().size() == 2);
+  CHECK(result["a-very-long-option-name"].as<std::string>() ==
+    "a text which does not fit inline");
+  CHECK(result.arguments().size() == 4);
+  CHECK(result.arguments()[3].value() == "a text which does not fit inline");
+
+  // Reparsing into the result keeps the resource.
+  const auto allocations = resource.allocations;
+  Argv second({"resource", "-n", "4"});
+  options.parse(second.argc(), second.argv(), result);
+  CHECK(result.get_allocator().resource() == &resource);
+  CHECK(resource.allocations == allocations);
+  CHECK(result["threads"].as<int>() == 4);
+  CHECK(result.count("verbose") == 0);
+
+  // Deferred texts are kept in the resource too.
+  options.lazy_conversion();
+  result = options.parse(av.argc(), av.argv(), &resource);
+  CHECK(resource.allocations > allocations);
+  CHECK(result["a-very-long-option-name"].as<std::string>() ==
+    "a text which does not fit inline");
+}
+#endif
+
+#ifdef CXXOPTS_HAS_STATIC_OPTIONS
+TEST_CASE("Static options", "[options]") {
+  using cxxopts::detail::parse_option_specifier;
+
+  static_assert(parse_option_specifier("f").valid);
+  static_assert(parse_option_specifier("f,").valid);
+  static_assert(parse_option_specifier("f, flag").long_name == "flag");
+  static_assert(parse_option_specifier("flag").short_name == 0);
+  static_assert(!parse_option_specifier("").valid);
+  static_assert(!parse_option_specifier("flag,f").valid);
+  static_assert(!parse_option_specifier(",flag").valid);
+  static_assert(!parse_option_specifier("f,-flag").valid);
+  static_assert(!parse_option_specifier("f,x").valid);
+
+  using cli = cxxopts::static_options<
+    cxxopts::opt<"v,verbose">,
+    cxxopts::opt<"d,debug">,
+    cxxopts::opt<"n,num", int>,
+    cxxopts::opt<"ratio", double>,
+    cxxopts::opt<"o,output", std::string>,
+    cxxopts::opt<"ids", std::vector<int>>>;
+
+  SECTION("Values") {
+    Argv av({"static", "-vd", "--num", "-5", "--ratio=0.5", "-ofile",
+      "input", "--ids", "1,2", "--ids=3", "--", "-v"});
+    const auto result = cli::parse(av.argc(), av.argv());
+
+    CHECK(result.get<"verbose">());
+    CHECK(result.get<"d">());
+    CHECK(result.get<"num">() == -5);
+    CHECK(result.get<"n">() == -5);
+    CHECK(result.get<"ratio">() == 0.5);
+    CHECK(result.get<"output">() == "file");
+    CHECK((result.get<"ids">() == std::vector<int>{1, 2, 3}));
+    CHECK(result.count<"ids">() == 2);
+    CHECK(result.count<"ratio">() == 1);
+
+    REQUIRE(result.unmatched().size() == 2);
+    CHECK(result.unmatched()[0] == "input");
+    CHECK(result.unmatched()[1] == "-v");
+  }
+
+  SECTION("Absent values") {
+    Argv av({"static", "-v", "-n3"});
+    const auto result = cli::parse(av.argc(), av.argv());
+
+    CHECK(result.get<"num">() == 3);
+    CHECK(result.count<"debug">() == 0);
+    CHECK_FALSE(result.get<"debug">());
+    CHECK(result.get<"output">().empty());
+  }
+
+  SECTION("Flag with value") {
+    Argv av({"static", "--verbose=false", "--debug", "true"});
+    const auto result = cli::parse(av.argc(), av.argv());
+
+    CHECK_FALSE(result.get<"verbose">());
+    CHECK(result.count<"verbose">() == 1);
+    CHECK(result.get<"debug">());
+    REQUIRE(result.unmatched().size() == 1);
+    CHECK(result.unmatched()[0] == "true");
+  }
+
+  SECTION("Errors") {
+    Argv unknown({"static", "--unknown"});
+    CHECK_THROWS_AS(cli::parse(unknown.argc(), unknown.argv()),
+      cxxopts::option_not_exists_error&);
+
+    Argv unknown_short({"static", "-vx"});
+    CHECK_THROWS_AS(cli::parse(unknown_short.argc(), unknown_short.argv()),
+      cxxopts::option_not_exists_error&);
+
+    Argv missing({"static", "--num"});
+    CHECK_THROWS_AS(cli::parse(missing.argc(), missing.argv()),
+      cxxopts::missing_argument_error&);
+
+    Argv option_as_value({"static", "-n", "--verbose"});
+    CHECK_THROWS_AS(cli::parse(option_as_value.argc(), option_as_value.argv()),
+      cxxopts::missing_argument_error&);
+
+    Argv incorrect({"static", "--num=x"});
+    CHECK_THROWS_AS(cli::parse(incorrect.argc(), incorrect.argv()),
+      cxxopts::argument_incorrect_type&);
+
+    Argv syntax({"static", "--a"});
+    CHECK_THROWS_AS(cli::parse(syntax.argc(), syntax.argv()),
+      cxxopts::option_syntax_error&);
+  }
+}
+#endif
+
+TEST_CASE("Struct options", "[options]") {
+  struct config {
+    bool verbose = false;
+    bool debug = false;
+    int threads = 1;
+    double ratio = 0;
+    std::string output = "a.out";
+    std::vector<std::string> inputs{};
+  };
+
+  cxxopts::struct_options<config> options("struct", " - bind options to fields");
+  options.add_options()
+    ("v,verbose", "Verbose output", &config::verbose)
+    ("d,debug", "Debug output", &config::debug)
+    ("n,threads", "Number of threads", &config::threads, "N")
+    ("o,output", "Output file", &config::output);
+  options.add_options("Input")
+    ("ratio", "Sampling ratio", &config::ratio)
+    ("i,input", "Input files", &config::inputs);
+
+  CHECK(options.size() == 6);
+  CHECK((options.groups() == std::vector<std::string>{"", "Input"}));
+
+  SECTION("Values") {
+    Argv av({"struct", "-vn", "4", "--ratio=0.5", "-i", "a,b", "--input=c",
+      "extra", "--", "-d"});
+    config cfg;
+    const auto unmatched = options.parse(av.argc(), av.argv(), cfg);
+
+    CHECK(cfg.verbose);
+    CHECK_FALSE(cfg.debug);
+    CHECK(cfg.threads == 4);
+    CHECK(cfg.ratio == 0.5);
+    CHECK(cfg.output == "a.out");
+    CHECK((cfg.inputs == std::vector<std::string>{"a", "b", "c"}));
+    REQUIRE(unmatched.size() == 2);
+    CHECK(unmatched[0] == "extra");
+    CHECK(unmatched[1] == "-d");
+  }
+
+  SECTION("Errors") {
+    config cfg;
+
+    Argv unknown({"struct", "--unknown"});
+    CHECK_THROWS_AS(options.parse(unknown.argc(), unknown.argv(), cfg),
+      cxxopts::option_not_exists_error&);
+
+    Argv missing({"struct", "-n", "-v"});
+    CHECK_THROWS_AS(options.parse(missing.argc(), missing.argv(), cfg),
+      cxxopts::missing_argument_error&);
+
+    Argv incorrect({"struct", "--threads", "many"});
+    CHECK_THROWS_AS(options.parse(incorrect.argc(), incorrect.argv(), cfg),
+      cxxopts::argument_incorrect_type&);
+  }
+
+  SECTION("Invalid specification") {
+    CHECK_THROWS_AS(options.add_options()("v,value", "", &config::threads),
+      cxxopts::option_exists_error&);
+    CHECK_THROWS_AS(options.add_options()("ratio", "", &config::ratio),
+      cxxopts::option_exists_error&);
+    CHECK_THROWS_AS(options.add_options()("flag,f", "", &config::debug),
+      cxxopts::invalid_option_format_error&);
+  }
+
+  SECTION("Help") {
+    const auto help = options.help();
+
+    CHECK(help.find("-n, --threads N") != std::string::npos);
+    CHECK(help.find("Sampling ratio") != std::string::npos);
+    CHECK(help.find("\nInput\n") != std::string::npos);
+  }
+}
@@ -0,0 +1,122 @@
+#include "catch.hpp"
+#include "cxxopts.hpp"
+#include "argv.hpp"
+
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Concurrent parsing", "[parse result]") {
+  cxxopts::options options("concurrent", " - test concurrent parsing");
+  options.add_options()
+    ("n,number", "a number", cxxopts::value<int>())
+    ("l,list", "a list", cxxopts::value<std::vector<std::string>>());
+  options.compile();
+
+  std::vector<std::thread> threads;
+  std::vector<int> failures(4, 0);
+
+  for (int t = 0; t != 4; ++t) {
+    threads.emplace_back([&options, &failures, t] () {
+      const std::string number = std::to_string(t);
+      const Argv argv({"concurrent", "-n", number.c_str(), "-l", "a,b"});
+
+      for (int i = 0; i != 200; ++i) {
+        const auto result = options.parse(argv.argc(), argv.argv());
+        if (result["number"].as<int>() != t ||
+            result["list"].as<std::vector<std::string>>().size() != 2) {
+          ++failures[t];
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  CHECK((failures == std::vector<int>{0, 0, 0, 0}));
+}
+
+TEST_CASE("Lazy conversion by several threads", "[parse result]") {
+  cxxopts::options options("lazy", " - test lazy conversion");
+  options.add_options()
+    ("l,list", "a list", cxxopts::value<std::vector<int>>())
+    ("d,default", "a default", cxxopts::value<std::vector<int>>()
+      ->default_value("7,8"));
+  options.lazy_conversion();
+
+  const Argv argv({"lazy", "-l", "1,2", "--list=3"});
+  const auto result = options.parse(argv.argc(), argv.argv());
+  const auto copy = result;
+
+  const auto read = [&result, &copy](std::size_t& sum) {
+    for (const auto* r : {&result, &copy}) {
+      for (const auto i : (*r)["list"].as<std::vector<int>>()) {
+        sum += static_cast<std::size_t>(i);
+      }
+      for (const auto i : (*r)["default"].as<std::vector<int>>()) {
+        sum += static_cast<std::size_t>(i);
+      }
+    }
+  };
+
+  std::size_t first = 0;
+  std::size_t second = 0;
+  std::thread thread(read, std::ref(first));
+  read(second);
+  thread.join();
+
+  CHECK(first == 42);
+  CHECK(second == 42);
+}
+
+TEST_CASE("Parse batch", "[parse result]") {
+  cxxopts::options options("batch", " - test batch parsing");
+  options.add_options()
+    ("n,number", "a number", cxxopts::value<int>())
+    ("files", "files", cxxopts::value<std::vector<std::string>>());
+  options.parse_positional("files");
+
+  std::vector<std::vector<std::string>> commands;
+  for (int i = 0; i != 100; ++i) {
+    if (i % 10 == 3) {
+      commands.push_back({"batch", "--number", "x"});
+    } else {
+      commands.push_back({"batch", "-n", std::to_string(i), "a", "b"});
+    }
+  }
+
+  const auto results = options.parse_batch(commands, 4);
+
+  REQUIRE(results.size() == commands.size());
+  for (std::size_t i = 0; i != results.size(); ++i) {
+    if (i % 10 == 3) {
+      CHECK(results[i].failed);
+      CHECK(!results[i].error.empty());
+    } else {
+      REQUIRE(!results[i].failed);
+      CHECK(results[i].result["number"].as<int>() == static_cast<int>(i));
+      CHECK(results[i].result.count("files") == 2);
+    }
+  }
+
+  const std::vector<std::vector<const char*>> single = {{"batch", "-n", "1"}};
+  const auto one = options.parse_batch(single);
+  REQUIRE(one.size() == 1);
+  CHECK(one[0].result["number"].as<int>() == 1);
+
+  SECTION("Bound values") {
+    int bound = 0;
+    options.add_options()("b,bound", "a bound number", cxxopts::value(bound));
+
+    std::vector<std::vector<std::string>> lines;
+    for (int i = 0; i != 50; ++i) {
+      lines.push_back({"batch", "-b", std::to_string(i)});
+    }
+    const auto bound_results = options.parse_batch(lines, 4);
+    REQUIRE(bound_results.size() == lines.size());
+    // Lines are parsed in order on one thread.
+    CHECK(bound == 49);
+  }
+}